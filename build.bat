@@ -19,6 +19,10 @@ ccache.exe clang++ -c -o bin/obj/Timer.o src/Timer.cpp -g %flags%
 ccache.exe clang++ -c -o bin/obj/Audio.o src/Audio.cpp -g %flags%
 ccache.exe clang++ -c -o bin/obj/Tile.o src/Tile.cpp   -g %flags%
 ccache.exe clang++ -c -o bin/obj/Grid.o src/Grid.cpp   -g %flags%
+ccache.exe clang++ -c -o bin/obj/TaskScheduler.o src/TaskScheduler.cpp -g %flags%
+ccache.exe clang++ -c -o bin/obj/MapGenerator.o src/MapGenerator.cpp -g %flags%
+ccache.exe clang++ -c -o bin/obj/TimerWheel.o src/TimerWheel.cpp -g %flags%
+ccache.exe clang++ -c -o bin/obj/ChunkStreamer.o src/ChunkStreamer.cpp -g %flags%
 ccache.exe clang++ -c -o bin/obj/Color.o src/Color.cpp -g %flags%
 ccache.exe clang++ -c -o bin/obj/Random.o src/Random.cpp -g %flags%
 ccache.exe clang++ -c -o bin/obj/UnitManager.o src/UnitManager.cpp -g %flags%
@@ -32,6 +36,6 @@ ccache.exe clang++ -c -o bin/obj/imgui_widgets.o src/imgui_widgets.cpp -g %flags
 ccache.exe clang++ -c -o bin/obj/imgui.o src/imgui.cpp -g %flags%
 
 
-clang++ -o bin/game.exe -g bin/obj/Game.o bin/obj/Engine.o bin/obj/Graphics.o bin/obj/GUI.o bin/obj/Image.o bin/obj/Input.o bin/obj/Timer.o bin/obj/Audio.o bin/obj/Tile.o bin/obj/Grid.o bin/obj/Color.o bin/obj/Random.o bin/obj/UnitManager.o bin/obj/imgui_demo.o bin/obj/imgui_draw.o bin/obj/imgui_tables.o bin/obj/imgui_widgets.o bin/obj/imgui.o bin/obj/Serialization.o bin/obj/Platform.o
+clang++ -o bin/game.exe -g bin/obj/Game.o bin/obj/Engine.o bin/obj/Graphics.o bin/obj/GUI.o bin/obj/Image.o bin/obj/Input.o bin/obj/Timer.o bin/obj/Audio.o bin/obj/Tile.o bin/obj/Grid.o bin/obj/TaskScheduler.o bin/obj/MapGenerator.o bin/obj/TimerWheel.o bin/obj/ChunkStreamer.o bin/obj/Color.o bin/obj/Random.o bin/obj/UnitManager.o bin/obj/imgui_demo.o bin/obj/imgui_draw.o bin/obj/imgui_tables.o bin/obj/imgui_widgets.o bin/obj/imgui.o bin/obj/Serialization.o bin/obj/Platform.o
 
 bin\game.exe
\ No newline at end of file
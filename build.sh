@@ -22,6 +22,10 @@ FLAGS="-std=c++20 \
 ./ccache clang++ -c -o bin/obj/Audio.o src/Audio.cpp -g $FLAGS
 ./ccache clang++ -c -o bin/obj/Tile.o src/Tile.cpp   -g $FLAGS
 ./ccache clang++ -c -o bin/obj/Grid.o src/Grid.cpp   -g $FLAGS
+./ccache clang++ -c -o bin/obj/TaskScheduler.o src/TaskScheduler.cpp -g $FLAGS
+./ccache clang++ -c -o bin/obj/MapGenerator.o src/MapGenerator.cpp -g $FLAGS
+./ccache clang++ -c -o bin/obj/TimerWheel.o src/TimerWheel.cpp -g $FLAGS
+./ccache clang++ -c -o bin/obj/ChunkStreamer.o src/ChunkStreamer.cpp -g $FLAGS
 ./ccache clang++ -c -o bin/obj/Color.o src/Color.cpp -g $FLAGS
 ./ccache clang++ -c -o bin/obj/Random.o src/Random.cpp -g $FLAGS
 ./ccache clang++ -c -o bin/obj/UnitManager.o src/UnitManager.cpp -g $FLAGS
@@ -33,7 +37,7 @@ FLAGS="-std=c++20 \
 ./ccache clang++ -c -o bin/obj/imgui_widgets.o src/imgui_widgets.cpp -g $FLAGS
 ./ccache clang++ -c -o bin/obj/imgui.o src/imgui.cpp -g $FLAGS
 
-clang++ -o bin/game -g bin/obj/Game.o bin/obj/Engine.o bin/obj/Platform.o bin/obj/Graphics.o bin/obj/GUI.o bin/obj/Image.o bin/obj/Input.o bin/obj/Timer.o bin/obj/Audio.o bin/obj/Tile.o bin/obj/Grid.o bin/obj/Color.o bin/obj/Random.o bin/obj/UnitManager.o bin/obj/imgui_demo.o bin/obj/imgui_draw.o bin/obj/imgui_tables.o bin/obj/imgui_widgets.o bin/obj/imgui.o bin/obj/Serialization.o \
+clang++ -o bin/game -g bin/obj/Game.o bin/obj/Engine.o bin/obj/Platform.o bin/obj/Graphics.o bin/obj/GUI.o bin/obj/Image.o bin/obj/Input.o bin/obj/Timer.o bin/obj/Audio.o bin/obj/Tile.o bin/obj/Grid.o bin/obj/TaskScheduler.o bin/obj/MapGenerator.o bin/obj/TimerWheel.o bin/obj/ChunkStreamer.o bin/obj/Color.o bin/obj/Random.o bin/obj/UnitManager.o bin/obj/imgui_demo.o bin/obj/imgui_draw.o bin/obj/imgui_tables.o bin/obj/imgui_widgets.o bin/obj/imgui.o bin/obj/Serialization.o \
     -framework OpenGL -framework Cocoa -framework MetalKit -framework Quartz -framework AudioToolbox
     #-fsanitize=address
 
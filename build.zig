@@ -40,6 +40,10 @@ const source_files = &[_][]const u8 {
     "src/Audio.cpp",
     "src/Tile.cpp",
     "src/Grid.cpp",
+    "src/TaskScheduler.cpp",
+    "src/MapGenerator.cpp",
+    "src/TimerWheel.cpp",
+    "src/ChunkStreamer.cpp",
     "src/Color.cpp",
     "src/Random.cpp",
     "src/UnitManager.cpp",
@@ -1 +1,3 @@
-C:\tools\sokol-tools-bin\bin\win32\sokol-shdc.exe --input shader/basic-sapp.glsl --output libs/include/basic-sapp.glsl.h --slang hlsl5:glsl330
\ No newline at end of file
+C:\tools\sokol-tools-bin\bin\win32\sokol-shdc.exe --input shader/basic-sapp.glsl --output libs/include/basic-sapp.glsl.h --slang hlsl5:glsl330
+C:\tools\sokol-tools-bin\bin\win32\sokol-shdc.exe --input shader/ground-sapp.glsl --output libs/include/ground-sapp.glsl.h --slang hlsl5:glsl330
+C:\tools\sokol-tools-bin\bin\win32\sokol-shdc.exe --input shader/sprite-sapp.glsl --output libs/include/sprite-sapp.glsl.h --slang hlsl5:glsl330
\ No newline at end of file
@@ -0,0 +1,5 @@
+SHDC=${SHDC:-sokol-shdc}
+
+$SHDC --input shader/basic-sapp.glsl --output libs/include/basic-sapp.glsl.h --slang hlsl5:glsl330
+$SHDC --input shader/ground-sapp.glsl --output libs/include/ground-sapp.glsl.h --slang hlsl5:glsl330
+$SHDC --input shader/sprite-sapp.glsl --output libs/include/sprite-sapp.glsl.h --slang hlsl5:glsl330
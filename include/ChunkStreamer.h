@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+struct Chunk;
+
+// Page chunks in and out of a chunk file on a background thread, the jobs are done in the order they are queued
+class ChunkStreamer
+{
+public:
+	explicit ChunkStreamer(const char* filePath);
+	~ChunkStreamer();
+
+	// Size of a chunk in the chunk file, a chunk keeps its record once it has one
+	static const int64_t RecordSize;
+
+	// False when the chunk file couldn't be opened, nothing can be paged out then
+	[[nodiscard]] bool IsOpen() const { return _file != nullptr; }
+	// A read or a write failed, the records can't be trusted anymore
+	[[nodiscard]] bool HasFailed() const { return _hasFailed; }
+
+	// Take the ownership of the chunk, write it at its record then delete it
+	// If the write fails, the chunk comes back with PopLoaded instead
+	void Write(int chunkX, int chunkY, Chunk* chunk, int64_t record);
+	// Read the record in the background, the chunk can be taken with PopLoaded once it's done
+	void Read(int chunkX, int chunkY, int64_t record);
+	// The chunks come out in the order of their jobs
+	bool PopLoaded(int& chunkX, int& chunkY, Chunk*& chunk);
+
+	// Wait for all the queued jobs to be done
+	void Flush();
+	// Read the record on the calling thread, only after a flush
+	Chunk* ReadNow(int64_t record);
+	// Forget all the records, only after a flush
+	void Clear();
+
+	int64_t AllocateRecord() { return _recordCount++ * RecordSize; }
+
+private:
+	struct Job
+	{
+		Chunk* Chunk;
+		int ChunkX;
+		int ChunkY;
+		int64_t Record;
+	};
+
+	struct LoadedChunk
+	{
+		Chunk* Chunk;
+		int ChunkX;
+		int ChunkY;
+	};
+
+	FILE* _file;
+	int64_t _recordCount = 0;
+	std::atomic<bool> _hasFailed = false;
+
+	std::thread _thread;
+	std::mutex _mutex;
+	std::condition_variable _jobAdded;
+	std::condition_variable _jobsDone;
+	// A job without chunk is a read
+	std::deque<Job> _jobs;
+	std::deque<LoadedChunk> _loaded;
+	bool _isBusy = false;
+	bool _isStopping = false;
+
+	void run();
+	// Tell if the whole record was read or written
+	bool serializeRecord(Chunk* chunk, int64_t record, bool isWriting);
+};
@@ -13,4 +13,6 @@ struct DrawableObject
     float Rotation = 0;
     Color Color{ 1.f, 1.f, 1.f, 1.f };
     Texture Texture = {};
+    // Skip the visibility test when the caller already culled the object
+    bool IsCulled = false;
 };
\ No newline at end of file
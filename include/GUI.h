@@ -14,9 +14,12 @@ namespace GUI
 
     void DrawStartMenu(bool* gameStarted);
 
-    void DrawPauseMenu(bool* gamePaused);
+    void DrawPauseMenu(bool* gamePaused, bool* fastForward);
 
-    void DrawTileInventory(Tile& tile, bool* isMouseOnAWindow);
+    // Throughput of the fast forward
+    void DrawSimulationSpeed(float ticksPerSecond, int realTimeTicksPerSecond);
+
+    void DrawTileInventory(const Tile& tile, bool* isMouseOnAWindow);
 
     void DrawConstructionMenu(int* buildingSelected, Vector2F* screenSize, ImTextureID* imTilemapTextureID);
 };
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "DrawableObject.h"
 #include "Constants.h"
 #include <vector>
+#include <span>
 #include "Serialization.h"
 
 struct ImGuiContext;
@@ -19,6 +20,90 @@ struct Vertex
     float U = -1, V = -1; // -1 means no texture
 };
 
+// Vertex of the shapes as it's uploaded
+struct PackedVertex
+{
+    // Screen space
+    Vector2F Position;
+    // 8 bits a channel in the order red, green, blue, alpha
+    uint8_t Color[4];
+    // Normalized uvs, U keeps 15 bits and its lowest bit tells if the vertex is textured
+    uint16_t U, V;
+};
+
+static_assert(sizeof(PackedVertex) == 16, "The vertexes are uploaded as they are");
+
+// Corners of a sprite in the atlas
+struct SpriteUvs
+{
+    Vector2F Min;
+    Vector2F Max;
+};
+
+// A sprite or a flat rectangle, drawn as an instance of a quad that the vertex shader places and maps on the atlas
+struct SpriteInstance
+{
+    // Top left corner in world space
+    Vector2F Position;
+    Vector2F Size;
+    // Sheet and sprite index in the sheet, the sheet is FlatSheet for a flat color
+    uint8_t Sprite[4];
+    // 8 bits a channel in the order red, green, blue, alpha
+    uint8_t Color[4];
+
+    static constexpr uint8_t FlatSheet = 255;
+};
+
+static_assert(sizeof(SpriteInstance) == 24, "The sprite instances are uploaded as they are");
+
+// Where a sprite of the draw list goes, the layers are drawn in this order
+enum class DrawLayer : uint8_t
+{
+    // Land and roads, when the tilemap pass doesn't draw them
+    Ground,
+    // Flat rectangles over the ground, like the construction progress
+    GroundOverlay,
+    // Buildings, trees and units, sorted by the bottom of their sprite so the lower ones are in front
+    Objects,
+    // The tile under the mouse
+    Cursor
+};
+
+// Sort key of a sprite of the draw list and where the sprite is in it
+struct DrawKey
+{
+    // The layer in the top byte, then the sortable bits of the y sort and the sheet
+    uint64_t Key;
+    int Sprite;
+};
+
+// Part of the draw list filled by a thread. The sprites are counted first, then written from the index
+// PlaceDrawListRanges gave to the range, so the list is the same as if a single thread had queued them
+struct DrawListRange
+{
+    // Where the next sprite is written, -1 while the sprites are counted
+    int Next = -1;
+    int Count = 0;
+
+    void Add(DrawLayer layer, Vector2F position, Vector2F size, Texture texture, Color color = Color::White);
+};
+
+enum class DrawCallType
+{
+    Shapes, Sprites
+};
+
+// Consecutive shapes or sprites drawn by the engine with a single draw, in the order they were added
+struct DrawCall
+{
+    DrawCallType Type;
+    // First index of the shapes or first instance of the sprites
+    int First;
+    int Count;
+    // World to screen transformation of the sprites, the rows of the matrix padded to 4 floats
+    float Transform[2][4];
+};
+
 struct Camera
 {
     Vector2F Position = { 0, 0 };
@@ -33,12 +118,38 @@ struct ImGuiData
     ImGuiIO* IO;
 };
 
+// Ground layer drawn by the tilemap pass of the engine, a quad over the screen that reads the sprite of each tile in a texture
+struct GroundData
+{
+	// Sheet and sprite index of each tile, 2 bytes a tile, the tiles wrap around the texture
+	uint8_t* TilesPtr = nullptr;
+	// The tiles changed since the last upload
+	bool IsDirty = false;
+	// False when the ground is drawn with the other sprites
+	bool IsVisible = false;
+	// Tile coordinates of the top left and the bottom right corners of the screen
+	float View[4] = {};
+	// World bounds in tiles, then the atlas geometry of the land and the road sheets, laid out like the uniforms of the shader
+	float Sheets[5][4] = {};
+};
+
 struct FrameData
 {
-	float* vertexBufferPtr;
+	PackedVertex* vertexBufferPtr;
 	int vertexBufferUsed;
 	uint32_t* indexBufferPtr;
 	int indexBufferUsed;
+	SpriteInstance* instanceBufferPtr;
+	int instanceBufferUsed;
+	DrawCall* drawCallPtr;
+	int drawCallUsed;
+	// The buffers are the ones of the previous frame when false, the engine draws what it has without uploading them
+	bool isGeometryDirty;
+	// Atlas geometry of each sheet for the sprite shader, see GetSheetGeometry
+	float sheetCells[(int)TileSheet::Count][4];
+	float sheetOrigins[(int)TileSheet::Count][4];
+
+	GroundData ground;
 
 	Vector2I screenSize;
 	Vector2F screenCenter;
@@ -56,17 +167,39 @@ struct TextureData
 
 namespace Graphics
 {
-    inline const int VertexNbAttributes = 10;
+    // The frame buffers grow to the biggest frame and are kept, only their counters are reset between frames
+    inline const int startBufferCapacity = 16384;
 
-    inline const int maxVertexes = 110000;
-    inline float vertexes[maxVertexes];
+    inline std::vector<PackedVertex> vertexes;
     inline int vertexesUsed = 0;
 
-    inline uint32_t indices[maxVertexes];
+    inline std::vector<uint32_t> indices;
     inline int indicesUsed = 0;
 
+    inline std::vector<SpriteInstance> sprites;
+    inline int spritesUsed = 0;
+
+    inline std::vector<DrawCall> drawCalls;
+    inline int drawCallsUsed = 0;
+
+    // Sprites queued in any order with QueueSprite, sorted and added to the sprites by FlushDrawList
+    inline std::vector<SpriteInstance> drawListSprites;
+    inline std::vector<DrawKey> drawKeys;
+    inline int drawListUsed = 0;
+
+    // Ground of the tilemap pass, the tiles wrap around a window of this size so it must be bigger than the screen
+    inline const int groundMapSize = 128;
+    inline uint8_t groundTiles[groundMapSize * groundMapSize * 2];
+    inline GroundData ground = { .TilesPtr = groundTiles };
+    // Draw the ground with quads like the other sprites when disabled
+    inline bool isGroundMapEnabled = true;
+
     inline Camera camera;
 
+    // World area the camera can't leave
+    inline Vector2F cameraMinBounds = { -2500, -2500 };
+    inline Vector2F cameraMaxBounds = { 2500, 2500 };
+
     inline float MinZoom = 0.7f;
     inline float MaxZoom = 2.f;
 
@@ -88,15 +221,34 @@ namespace Graphics
     inline int textureWidth = 0;
     inline int textureHeight = 0;
 
+    // Uvs of every sprite of the atlas baked by BakeUvs, the sprites of a sheet follow each other from its first one
+    inline std::vector<SpriteUvs> uvTable;
+    inline int sheetFirstSprite[(int)TileSheet::Count + 1];
+    inline float sheetCells[(int)TileSheet::Count][4];
+    inline float sheetOrigins[(int)TileSheet::Count][4];
+
     int GetFrameCount();
 	void IncreaseFrameCount();
 
+	/**
+	 * @brief Work out the uvs of every sprite once the size of the atlas is known
+	 */
+	void BakeUvs();
+
     /**
 	 * @brief Get the UVs for a texture name
 	 * @param texture The texture
-	 * @return The 4 uvs positions for the texture
+	 * @return The top left and bottom right uvs of the texture, from the table baked by BakeUvs
+	 */
+    const SpriteUvs& GetUvs(Texture texture);
+
+	/**
+	 * @brief Get where the sprites of a sheet are in the atlas, for the shaders that find the uvs themselves
+	 * @param sheet The sheet
+	 * @param cell Filled with the distance between 2 sprites in x, 0, then the size of the sampled part of a sprite
+	 * @param origin Filled with the top left uv of the first sprite, then 0, 0
 	 */
-    std::vector <Vector2F> GetUvs(Texture texture);
+	void GetSheetGeometry(TileSheet sheet, float cell[4], float origin[4]);
 
 	/**
 	 * @brief Get the transformed position for the given parameters
@@ -116,9 +268,58 @@ namespace Graphics
 	 * @param position The position in the screen space, starting from the top left corner
 	 * @param size The size of the rectangle
 	 * @param color The color of the rectangle
-	 * @param uvs Needed if using a texture
+	 * @param uvs Needed if using a texture, the rectangle is then drawn with vertexes instead of a sprite instance
+	 * @param isCulled Skip the visibility test when the caller already knows the rectangle is on screen
 	 */
-    void DrawRect(Vector2F position, Vector2F size, Color color, std::vector <Vector2F> uvs = {});
+    void DrawRect(Vector2F position, Vector2F size, Color color, const SpriteUvs* uvs = nullptr, bool isCulled = false);
+
+	/**
+	 * @brief Draw a sprite, written as it is to the sprite instances
+	 * @param position The top left corner in world space
+	 * @param size The size of the sprite
+	 * @param texture The sprite, or no texture for a flat rectangle
+	 * @param color Multiplied with the sprite
+	 * @param isCulled Skip the visibility test when the caller already knows the sprite is on screen
+	 */
+	void DrawSprite(Vector2F position, Vector2F size, Texture texture, Color color = Color::White, bool isCulled = false);
+
+	/**
+	 * @brief Queue a sprite in the draw list, it's drawn by FlushDrawList in the order of its layer and position
+	 * @param layer The layer of the sprite
+	 * @param position The top left corner in world space
+	 * @param size The size of the sprite
+	 * @param texture The sprite, or no texture for a flat rectangle
+	 * @param color Multiplied with the sprite
+	 * @param isCulled Skip the visibility test when the caller already knows the sprite is on screen
+	 */
+	void QueueSprite(DrawLayer layer, Vector2F position, Vector2F size, Texture texture, Color color = Color::White, bool isCulled = false);
+
+	/**
+	 * @brief Reserve the sprites counted by the ranges at the end of the draw list and give each range its first index, in the order of the ranges
+	 * @param ranges The ranges once their sprites are counted, they write them with DrawListRange::Add afterwards
+	 */
+	void PlaceDrawListRanges(std::span<DrawListRange> ranges);
+
+	/**
+	 * @brief Sort the draw list by layer, y and sheet, then draw its sprites after the ones already drawn
+	 */
+	void FlushDrawList();
+
+	/**
+	 * @brief Set the sprite of a tile in the ground of the tilemap pass
+	 * @param x The tile position in x, wrapped around the ground window
+	 * @param y The tile position in y, wrapped around the ground window
+	 * @param texture A land or a road sprite
+	 */
+	void SetGroundTile(int x, int y, Texture texture);
+
+	/**
+	 * @brief Draw the ground with the tilemap pass this frame instead of quads
+	 * @param worldMin The top left corner of the world in world space
+	 * @param worldMax The bottom right corner of the world in world space, excluded
+	 * @param tileSize The size of a tile in world space
+	 */
+	void DrawGround(Vector2F worldMin, Vector2F worldMax, float tileSize);
 
 	/**
 	 * @brief Draw a circle
@@ -143,7 +344,7 @@ namespace Graphics
 	 * @param points The points to draw the shape with
 	 * @param color The color of the shape
 	 */
-	void DrawCustomShape(std::vector<Vector2F> points, Color color);
+	void DrawCustomShape(std::span<const Vector2F> points, Color color);
 
 	/**
 	 * @brief Draw an object according to its properties
@@ -167,6 +368,13 @@ namespace Graphics
 
 	void SetCameraSize(float width, float height);
 
+	/**
+	 * @brief Set the world area the camera can move in
+	 * @param min The top left corner of the area in world space
+	 * @param max The bottom right corner of the area in world space
+	 */
+	void SetCameraBounds(Vector2F min, Vector2F max);
+
 	void CalculTransformationMatrix(Vector2F scale = {camera.Zoom, camera.Zoom});
 
     Vector2F ScreenToWorld(Vector2F vec);
@@ -180,6 +388,14 @@ namespace Graphics
 	void ClearFrameBuffers();
 
 	bool IsVisible(Vector2F position, Vector2F size);
+
+	/**
+	 * @brief Get the world area seen by the camera, worked out once from the inverse transformation matrix
+	 * @param min The top left corner in world space
+	 * @param max The bottom right corner in world space
+	 * @param margin Added on every side in world space, for the sprites that go past their position
+	 */
+	void GetVisibleArea(Vector2F& min, Vector2F& max, float margin = 0.f);
 }
 
 struct Serializer;
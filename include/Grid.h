@@ -1,12 +1,26 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <shared_mutex>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
-#include <functional>
 
 #include "Tile.h"
 #include "Maths.h"
 #include "Serialization.h"
+#include "Graphics.h"
+#include "TimerWheel.h"
+#include "Random.h"
 
 struct TilePosition
 {
@@ -29,48 +43,519 @@ struct TilePosition
     }
 };
 
+// A square block of tiles, only allocated once something else than grass is on it
+struct Chunk
+{
+	static constexpr int Shift = 6;
+	static constexpr int Size = 1 << Shift;
+	static constexpr int TileCount = Size * Size;
+
+	Tile Tiles[TileCount];
+};
+
+// Bit planes of a chunk with one 64 bits word per row of tiles, the bit X of a row is the tile X of the chunk
+struct ChunkPlanes
+{
+	// The first planes are the tile types, None is unused
+	static constexpr int Built = (int)TileType::Count;
+	static constexpr int MarkedForDestruction = Built + 1;
+	static constexpr int MatureTree = Built + 2;
+	// Then a plane per item for the tiles that store some of it
+	static constexpr int FirstItem = Built + 3;
+	static constexpr int Count = FirstItem + (int)Items::Count;
+
+	uint64_t Rows[Count][Chunk::Size] = {};
+};
+
+static_assert(Chunk::Size == 64, "A chunk row must fit in a plane word");
+
+// Planes a tile must have, must not have and must have at least one of to match
+struct TileQuery
+{
+	uint32_t Required = 0;
+	uint32_t Excluded = 0;
+	uint32_t AnyOf = 0;
+
+	// The planes of every tile type, None is unused
+	static constexpr uint32_t TypePlanes = ((1u << (int)TileType::Count) - 1) & ~1u;
+
+	[[nodiscard]] static constexpr uint32_t Plane(int plane) { return 1u << plane; }
+	[[nodiscard]] static constexpr uint32_t Plane(TileType type) { return 1u << (int)type; }
+
+	// Built tiles of the type, or of any type except None
+	[[nodiscard]] static constexpr TileQuery Built(TileType type) { return { Plane(type) | Plane(ChunkPlanes::Built), 0 }; }
+	[[nodiscard]] static constexpr TileQuery Built() { return { Plane(ChunkPlanes::Built), 0 }; }
+	[[nodiscard]] static constexpr TileQuery MatureTrees() { return { Plane(TileType::Tree) | Plane(ChunkPlanes::Built) | Plane(ChunkPlanes::MatureTree), Plane(ChunkPlanes::MarkedForDestruction) }; }
+	// Every tile that is not grass, built or not
+	[[nodiscard]] static constexpr TileQuery Any() { return { 0, 0, TypePlanes }; }
+
+	// The tiles of a row of the chunk that match, a bit per tile
+	[[nodiscard]] uint64_t Match(const ChunkPlanes& planes, int row) const
+	{
+		uint64_t word = ~uint64_t(0);
+
+		for (uint32_t required = Required; required != 0; required &= required - 1)
+		{
+			word &= planes.Rows[std::countr_zero(required)][row];
+		}
+
+		for (uint32_t excluded = Excluded; excluded != 0; excluded &= excluded - 1)
+		{
+			word &= ~planes.Rows[std::countr_zero(excluded)][row];
+		}
+
+		if (AnyOf == 0) return word;
+
+		uint64_t any = 0;
+
+		for (uint32_t anyOf = AnyOf; anyOf != 0; anyOf &= anyOf - 1)
+		{
+			any |= planes.Rows[std::countr_zero(anyOf)][row];
+		}
+
+		return word & any;
+	}
+};
+
+static_assert(ChunkPlanes::Count <= 32, "The planes of a query must fit in 32 bits");
+
+class Grid;
+
+// Tiles matching a query in a rectangle, visited row by row without allocation
+class TileQueryRange
+{
+public:
+	class Iterator
+	{
+	public:
+		TilePosition operator*() const { return _position; }
+		Iterator& operator++() { next(); return *this; }
+		bool operator!=(const Iterator& other) const { return _isDone != other._isDone; }
+
+	private:
+		friend class TileQueryRange;
+
+		const TileQueryRange* _range = nullptr;
+		int _y = 0;
+		int _chunkX = 0;
+		// Tiles left to visit in the current row of the current chunk
+		uint64_t _word = 0;
+		TilePosition _position;
+		bool _isDone = true;
+
+		void next();
+	};
+
+	TileQueryRange(const Grid* grid, TileQuery query, TilePosition min, TilePosition max) : _grid(grid), _query(query), _min(min), _max(max) {}
+
+	[[nodiscard]] Iterator begin() const;
+	[[nodiscard]] Iterator end() const { return {}; }
+	[[nodiscard]] bool IsEmpty() const { return !(begin() != end()); }
+	[[nodiscard]] int Count() const;
+
+private:
+	const Grid* _grid;
+	TileQuery _query;
+	// Clipped to the world, both included
+	TilePosition _min;
+	TilePosition _max;
+
+	[[nodiscard]] uint64_t getWord(int chunkX, int y) const;
+};
+
+// Sprites of the tiles of a chunk, resolved again only when a tile or one of its neighbours changes
+struct ChunkRender
+{
+	Texture Backgrounds[Chunk::TileCount];
+	Texture Sprites[Chunk::TileCount];
+	// The tiles to resolve before the next draw, a bit per tile of each row
+	uint64_t DirtyRows[Chunk::Size];
+	bool IsDirty = true;
+	// The trees change stage with their age, they are resolved again when the first one does
+	int64_t NextTreeStageTick = INT64_MAX;
+
+	ChunkRender() { std::fill(std::begin(DirtyRows), std::end(DirtyRows), ~uint64_t(0)); }
+};
+
+// Entry of the chunk table
+struct ChunkSlot
+{
+	// nullptr when the chunk is only grass or paged out
+	std::unique_ptr<Chunk> Chunk;
+	// Kept in memory when the chunk is paged out, nullptr when the chunk is only grass
+	std::unique_ptr<ChunkPlanes> Planes;
+	// Offset of the chunk in the chunk file, -1 until it's paged out once
+	int64_t Record = -1;
+	bool IsPagedOut = false;
+	bool IsLoading = false;
+	// The least recently used chunks are paged out first
+	uint32_t LastUsedFrame = 0;
+	// Simulated at full detail near the camera and the player edits, the others use coarser steps
+	bool IsDetailed = false;
+	int64_t DetailedUntilTick = 0;
+	// Index of the dirty region of the chunk in the batch being recorded, -1 when nothing changed
+	int DirtyRegionIndex = -1;
+	// Allocated the first time the chunk is drawn, grass chunks included
+	std::unique_ptr<ChunkRender> Render;
+};
+
+// What changed on tiles, a bit each so the changes of several tiles can be merged
+enum class TileChange : uint8_t
+{
+	None = 0,
+	Type = 1 << 0,
+	Built = 1 << 1,
+	// Marked or unmarked for destruction
+	Destruction = 1 << 2,
+	// Construction or destruction progress
+	Progress = 1 << 3,
+	Inventory = 1 << 4,
+	TreeGrowth = 1 << 5,
+	// Burning or smelting in a furnace
+	Furnace = 1 << 6,
+	All = 0x7f
+};
+
+[[nodiscard]] constexpr TileChange operator|(TileChange a, TileChange b) { return (TileChange)((uint8_t)a | (uint8_t)b); }
+[[nodiscard]] constexpr bool HasChange(TileChange changes, TileChange change) { return ((uint8_t)changes & (uint8_t)change) != 0; }
+
+// Bounding rectangle of the changed tiles of a chunk, both included, and what changed on them
+struct DirtyRegion
+{
+	TilePosition Min;
+	TilePosition Max;
+	TileChange Changes = TileChange::None;
+};
+
+// The changes since the last batch, a region per chunk that changed
+struct TileChangeBatch
+{
+	int64_t Tick = 0;
+	std::span<const DirtyRegion> Regions;
+	// All the changes of the regions
+	TileChange Changes = TileChange::None;
+};
+
+using TileChangeListener = std::function<void(const TileChangeBatch&)>;
+
+// Pattern of tiles stamped on the grid, row major, None leaves the tile as it is
+struct Prefab
+{
+	int Width = 0;
+	int Height = 0;
+	std::vector<TileType> Tiles;
+
+	[[nodiscard]] TileType GetType(int x, int y) const { return Tiles[x + y * Width]; }
+};
+
+// Scheduled changes of a tile, an event is ignored if the tile changed since it was scheduled
+enum class TileEvent
+{
+	TreeMatures,
+	TreeSpawnRoll,
+	CoalBurnsOut,
+	IngotFinishes,
+	// Something changed on the tile, like its inventory
+	Wake
+};
+
+// Outcome of the spawn rolls of a tree, they can be drawn on any thread before the tick applies them
+struct SpawnRolls
+{
+	bool IsRolled = false;
+	int64_t FirstRollTick = 0;
+	// A bit per neighbour that gets a tree, in the order of ForEachNeighbour, and the tick each one is planted at
+	uint8_t Neighbours = 0;
+	int64_t PlantedTicks[4] = {};
+};
+
+class ChunkStreamer;
+class MapGenerator;
+
 class Grid
 {
 public:
 	Grid(int width, int height, int tileSize);
+	~Grid();
+
+	// The grid owns its chunks, its timer wheel and its streamer
+	Grid(const Grid&) = delete;
+	Grid& operator=(const Grid&) = delete;
+
+	// Empty the world and give it a new size at the tick 0, the change listeners, the streaming and the seed are kept
+	void Reset(int width, int height, int tileSize);
+
+	// Tile indexes stay the same when the world grows as long as it's smaller than this size in tiles
+	static constexpr int MaxWorldSize = 1 << 15;
 
-	int _width;
-	int _height;
 	int _tileSize;
 
-	Tile* _tiles;
+	// World bounds in chunks, the max is excluded
+	int _minChunkX;
+	int _minChunkY;
+	int _maxChunkX;
+	int _maxChunkY;
+
+	// Row major chunk table
+	std::vector<ChunkSlot> _chunks;
+	// Guard the chunk table against the pathfinding threads while it's reallocated
+	mutable std::shared_mutex _chunkTableMutex;
+
+	// Streaming, disabled until EnableStreaming is called
+	std::unique_ptr<ChunkStreamer> _streamer;
+	int _residentChunkBudget;
+	uint32_t _frame;
+
+	// Simulation, only the tiles with a due event are updated
+	std::unique_ptr<TimerWheel> _events;
+	std::vector<TimerEvent> _dueEvents;
+	// Drawn in parallel for the big batches of due events, by event
+	std::vector<SpawnRolls> _spawnRolls;
+	// Every random draw of the grid derives from it, so a seed always gives the same world
+	uint64_t _seed;
+
+	// Built tiles of each type in no particular order, paged out tiles included
+	std::vector<TilePosition> _builtTiles[(int)TileType::Count];
+	// Position of each built tile in its list, by tile index
+	std::unordered_map<int, int> _builtTileSlots;
+
+	// Change notification, the regions are recorded until PublishChanges sends them
+	std::vector<DirtyRegion> _dirtyRegions;
+	std::vector<DirtyRegion> _publishedRegions;
+	std::vector<std::pair<int, TileChangeListener>> _changeListeners;
+	int _nextChangeListenerId;
+
+	// Tiles written to the ground of the tilemap pass, both included, empty when the ground is drawn with quads
+	TilePosition _groundMin;
+	TilePosition _groundMax;
+	// Sprites of each band of rows queued by Draw
+	std::vector<DrawListRange> _drawBands;
+
+	// What the last Draw depended on besides the camera, see IsRenderDirty
+	bool _isRenderDirty;
+	int64_t _nextRenderTick;
+	TilePosition _drawnMouse;
+	bool _wasMouseOnAWindow;
 
 private:
+	// Shared empty grass tile returned for unallocated chunks
+	static const Tile _emptyTile;
+
+	[[nodiscard]] int getChunkSlot(int chunkX, int chunkY) const;
+	[[nodiscard]] Chunk* getChunk(TilePosition position) const;
+	Chunk* getOrCreateChunk(TilePosition position);
+	void releaseChunks();
+
+	// Streaming
+	[[nodiscard]] bool isPagedOut(TilePosition position) const;
+	void touchChunk(int slot);
+	void pageIn(int slot);
+	void installChunk(int chunkX, int chunkY, Chunk* chunk);
+	void pageOutLeastRecentlyUsed();
+
+	// Simulation
+	[[nodiscard]] Tile* getResidentTile(TilePosition position) const;
+	void startTile(Tile& tile, int64_t tick);
+	void scheduleTileEvents(const Tile& tile, TilePosition position);
+	void scheduleEvent(int64_t tick, TilePosition position, TileEvent event);
+	void scheduleSpawnRoll(const Tile& tile, TilePosition position);
+	// The spawn rolls are drawn when they are not given
+	void fireEvent(const TimerEvent& event, const SpawnRolls* spawnRolls);
+	[[nodiscard]] SpawnRolls rollSpawns(const Tile& tile, TilePosition position) const;
+	void spawnTrees(TilePosition position, const SpawnRolls& spawnRolls);
+	void updateFurnace(Tile& tile, TilePosition position, int64_t tick);
+	void scheduleChunkEvents(int chunkX, int chunkY, Chunk* chunk);
+	void demoteChunks();
+
+	// Built tile lists and planes, untrack a tile before changing its state and track it after
+	void trackTile(const Tile& tile, TilePosition position);
+	void untrackTile(const Tile& tile, TilePosition position);
+	// SetTile once the tile is found and started
+	void replaceTile(Tile& current, TilePosition position, const Tile& tile);
+	void rebuildTracking();
+	void setPlaneBit(TilePosition position, int plane, bool value);
+	// Follow the inventory of a tile in the item planes, after it changed
+	void setItemBits(const Tile& tile, TilePosition position);
+	[[nodiscard]] uint64_t getQueryWord(TileQuery query, int chunkX, int y, int minX, int maxX) const;
+
+	friend class TileQueryRange;
+
+	// Bulk edits
+	struct TileEdit
+	{
+		TilePosition Position;
+		TileType Type;
+	};
+
+	// The tiles of the row of the chunk where the type can be built, a bit per tile
+	[[nodiscard]] uint64_t getBuildableWord(TileType type, int chunkX, int y) const;
+	[[nodiscard]] bool isBuildable(TilePosition position, TileType type) const;
+	// Apply the edits if none was invalid or if partial edits are allowed, a chunk at a time
+	int applyEdits(const std::vector<TileEdit>& edits, int invalidCount, bool isBuilt, bool isPartial);
+
+	// Change notification
+	void markChanged(TilePosition position, TileChange changes);
+	void markChunkChanged(int slot, TileChange changes);
+
+	// Call a visitor and tell if the visit goes on, the visitors that return nothing never stop it
+	template<typename Visitor>
+	static bool visitTile(Visitor& visitor, Tile& tile, TilePosition position);
 
 	// Texture
-	static Texture getTreeTexture(Tile& tile);
+	[[nodiscard]] Texture getTreeTexture(const Tile& tile) const;
+	// Resolve the dirty sprites of the chunk
+	ChunkRender* getChunkRender(int slot);
+	void invalidateRender(const DirtyRegion& region);
+	// Write the sprite of the tile to the ground of the tilemap pass, the roads replace the land
+	void setGroundTile(TilePosition position, const ChunkRender& render, int tileIndex);
+	[[nodiscard]] bool isInGround(TilePosition position) const;
+	// Write the tiles of the ground window that weren't in the previous one, the renders of their chunks must be resolved
+	void writeNewGroundTiles(TilePosition previousMin, TilePosition previousMax);
 	Texture getRoadTexture(TilePosition position);
+	// A bit per neighbour of the type, in the order up, down, left, right, up left, up right, down left, down right
+	[[nodiscard]] uint8_t getNeighbourMask(TilePosition position, TileType type) const;
 
 public:
-    void Draw(bool drawLandAndRoads, bool isMouseOnAWindow);
+    // Queue the sprites of the tiles seen by the camera in the draw list, the land and roads go to the tilemap pass when it covers the screen
+    void Draw(bool isMouseOnAWindow);
+    // The sprites Draw would queue changed since the last Draw, with the same camera: a change was published, a tree reached its next stage or the mouse moved to another tile
+    [[nodiscard]] bool IsRenderDirty(bool isMouseOnAWindow) const;
+    // The tiles seen by the camera with a tile of margin, clipped to the world, the max is included
+    void GetVisibleTiles(TilePosition& min, TilePosition& max) const;
+    // Once per frame, page the chunks in and out
     void Update();
+    // Once per simulation tick
+    void Tick();
 
 	[[nodiscard]] int GetTileSize() const { return _tileSize; }
+	[[nodiscard]] int64_t GetTick() const { return _events->GetTick(); }
+	[[nodiscard]] size_t GetScheduledEventCount() const { return _events->GetEventCount(); }
+	[[nodiscard]] int GetWidth() const { return (_maxChunkX - _minChunkX) * Chunk::Size; }
+	[[nodiscard]] int GetHeight() const { return (_maxChunkY - _minChunkY) * Chunk::Size; }
+	[[nodiscard]] TilePosition GetMinTilePosition() const { return TilePosition{_minChunkX * Chunk::Size, _minChunkY * Chunk::Size}; }
+	// Excluded from the world
+	[[nodiscard]] TilePosition GetMaxTilePosition() const { return TilePosition{_maxChunkX * Chunk::Size, _maxChunkY * Chunk::Size}; }
+	[[nodiscard]] Vector2F GetWorldMin() const;
+	[[nodiscard]] Vector2F GetWorldMax() const;
+	[[nodiscard]] size_t GetAllocatedChunkCount() const;
+	[[nodiscard]] size_t GetResidentChunkCount() const;
+
+	void SetSeed(uint64_t seed) { _seed = seed; }
+	[[nodiscard]] uint64_t GetSeed() const { return _seed; }
+
+	/**
+	 * @brief The random stream of a tile for a key like a tick, it only depends on the seed, the tile and the key
+	 * so the result doesn't change with the order or the thread the tiles are simulated in
+	 */
+	[[nodiscard]] RandomStream GetTileRandom(TilePosition position, uint64_t key) const;
+
+	/**
+	 * @brief Add chunks to the borders of the world, existing tiles keep their position and index
+	 * @param left Number of chunks to add on the left
+	 * @param top Number of chunks to add on the top
+	 * @param right Number of chunks to add on the right
+	 * @param bottom Number of chunks to add on the bottom
+	 */
+	void Grow(int left, int top, int right, int bottom);
+	/**
+	 * @brief Fill the empty tiles of the world with the terrain of the generator, the chunks are generated in parallel.
+	 * The chunks that are paged out are kept as they are
+	 */
+	void Generate(const MapGenerator& generator);
+	// Grow the world by one chunk on each border the position is in
+	void GrowAround(TilePosition position);
+
+	/**
+	 * @brief Page the least recently used chunks to a chunk file when more than the budget are in memory.
+	 * Update only simulates the chunks in memory, the others catch up when they come back
+	 * @param chunkFilePath The file is overwritten
+	 * @param residentChunkBudget Maximum number of chunks in memory, except the ones used during the frame
+	 * @return False if the chunk file can't be opened, the chunks stay in memory then
+	 */
+	bool EnableStreaming(const char* chunkFilePath, int residentChunkBudget);
+	// Keep the chunks in memory for this frame and load them in the background if they are paged out
+	void PrefetchTile(TilePosition position);
+	void PrefetchArea(TilePosition min, TilePosition max);
+
+	/**
+	 * @brief Simulate the chunks of the area at full detail for a while.
+	 * The other chunks roll the tree spawns of several periods at once and their units skip the walking
+	 * @param duration In seconds of simulation
+	 */
+	void KeepDetailed(TilePosition min, TilePosition max, float duration);
+	[[nodiscard]] bool IsDetailed(TilePosition position) const;
 
 	[[nodiscard]] TilePosition GetTilePosition(Vector2F position) const;
 	[[nodiscard]] TilePosition GetTilePosition(int tileIndex) const;
     [[nodiscard]] Vector2F ToWorldPosition(TilePosition position) const;
 
+    // Allocate or load the chunk of the tile if it's not already done, use PeekTile to only read it
     Tile& GetTile(TilePosition position);
     Tile& GetTile(int index);
+    // Paged out tiles are seen as grass
+    [[nodiscard]] const Tile& PeekTile(TilePosition position) const;
     [[nodiscard]] int GetTileIndex(TilePosition position) const;
     [[nodiscard]] bool IsTileValid(TilePosition position) const;
 	bool IsRoad(TilePosition tp);
 
+    // Always change the type or the built state of a tile with these functions to keep the tile lists right
     void SetTile(TilePosition position, Tile tile);
     void RemoveTile(TilePosition position);
+    void ResetTile(TilePosition position);
+    // Change the type of the tile and build it right away, the inventory is kept
+    void SetTileType(TilePosition position, TileType type);
+    void FinishConstruction(TilePosition position);
+    void SetNeedToBeDestroyed(TilePosition position, bool needToBeDestroyed);
+    void SetTreeGrowth(TilePosition position, float treeGrowth);
+    // Negative to remove items, the simulation doesn't react to it until WakeTile
+    void AddItems(TilePosition position, Items item, int count);
+    // Construction or destruction progress, in seconds
+    void AddProgress(TilePosition position, float progress);
+    // Let the simulation react to a change of the inventory of the tile
+    void WakeTile(TilePosition position);
 
-    [[nodiscard]] std::vector<TilePosition> GetTiles(TileType type) const;
-	[[nodiscard]] std::vector<TilePosition> GetTiles(TileType type, TilePosition position, int radius) const;
-	[[nodiscard]] std::vector<TilePosition> GetTiles(TilePosition position, int radius) const;
+	/**
+	 * @brief Call the listener with the changes of the tiles, merged in a dirty region per chunk, each time they are published.
+	 * The tiles must only be changed with the functions of the grid to be seen.
+	 * Loading a game, paging a chunk in or out and generating it mark the whole chunk
+	 * @return The id to unsubscribe the listener
+	 */
+	int SubscribeToChanges(TileChangeListener listener);
+	void UnsubscribeFromChanges(int id);
+	// Once per tick, the changes made by the listeners go in the next batch
+	void PublishChanges();
+
+    // In seconds, up to 30
+    [[nodiscard]] float GetTreeGrowth(const Tile& tile) const;
+    [[nodiscard]] bool IsBurning(const Tile& tile) const;
+
+    // Built tiles of the type, the span is invalidated by the next change to the grid.
+    // Around a position, QueryTiles and CountTiles go through the bit planes without allocating
+    [[nodiscard]] std::span<const TilePosition> GetTiles(TileType type) const;
 	[[nodiscard]] std::vector<TilePosition> GetTilesWithItems(TileType type, Items item) const;
 
-	void ForEachTile(const std::function<void(Tile&, TilePosition)>& callback) const;
+	// Combine the bit planes of the chunks a word at a time, the area is clipped to the world and its max is included
+	[[nodiscard]] TileQueryRange QueryTiles(TileQuery query, TilePosition min, TilePosition max) const;
+	[[nodiscard]] TileQueryRange QueryTiles(TileQuery query, TilePosition position, int radius) const;
+	[[nodiscard]] int CountTiles(TileQuery query, TilePosition min, TilePosition max) const;
+	[[nodiscard]] int CountTiles(TileQuery query, TilePosition position, int radius) const;
+
+	/**
+	 * @brief Visit the tiles of the chunks in memory, the others are grass or paged out.
+	 * The tiles are visited chunk by chunk in memory order and the visitor is inlined, it can return false to stop
+	 * @return false when the visitor stopped the visit
+	 */
+	template<typename Visitor>
+	bool ForEachTile(Visitor&& visitor) const;
+	// Clipped to the world, the max is included
+	template<typename Visitor>
+	bool ForEachTile(TilePosition min, TilePosition max, Visitor&& visitor) const;
+	// The square around the position, like QueryTiles
+	template<typename Visitor>
+	bool ForEachTile(TilePosition position, int radius, Visitor&& visitor) const;
+	// Only the tiles matching the query, found a row of a chunk at a time in the bit planes
+	template<typename Visitor>
+	bool ForEachTile(TileQuery query, Visitor&& visitor) const;
 
 	Texture GetTexture(TilePosition position);
 
@@ -89,11 +574,158 @@ public:
 	bool CanBuild(TilePosition position, TileType type);
 	bool CanBeDestroyed(TilePosition position);
 
+	/**
+	 * @brief Bulk edits, the tiles are checked with the rules of CanBuild a row of a chunk at a time before anything changes,
+	 * then they change together so the listeners get one batch for the whole edit
+	 * @param isBuilt Build the buildings right away, the roads, trees and stones are always built
+	 * @param isPartial Skip the tiles that can't be built, otherwise nothing changes if one of them can't
+	 * @return The number of tiles changed
+	 */
+	int FillArea(TilePosition min, TilePosition max, TileType type, bool isBuilt, bool isPartial);
+	// The tiles of the line touch by their sides, so a road line is connected
+	int PaintLine(TilePosition from, TilePosition to, TileType type, bool isBuilt, bool isPartial);
+	int StampPrefab(const Prefab& prefab, TilePosition origin, bool isBuilt, bool isPartial);
+	// Remove the tiles of the area right away with the rules of CanBeDestroyed, the max is included
+	int ClearArea(TilePosition min, TilePosition max, bool isPartial);
+
 	// Pathfinding
-	std::vector<TilePosition> GetPath(TilePosition start, TilePosition end);
-	[[nodiscard]] std::vector<TilePosition> GetNeighbours(TilePosition position) const;
+	std::vector<TilePosition> GetPath(TilePosition start, TilePosition end) const;
+	// The 4 neighbours inside the world, left, right, up and down
+	template<typename Visitor>
+	void ForEachNeighbour(TilePosition position, Visitor&& visitor) const;
+
+	friend void Serialize(Serializer* ser, Grid* grid);
 };
 
+template<typename Visitor>
+bool Grid::visitTile(Visitor& visitor, Tile& tile, TilePosition position)
+{
+	if constexpr (std::is_void_v<std::invoke_result_t<Visitor&, Tile&, TilePosition>>)
+	{
+		visitor(tile, position);
+		return true;
+	}
+	else
+	{
+		return visitor(tile, position);
+	}
+}
+
+template<typename Visitor>
+bool Grid::ForEachTile(Visitor&& visitor) const
+{
+	int slot = 0;
+
+	for (int chunkY = _minChunkY; chunkY < _maxChunkY; chunkY++)
+	{
+		for (int chunkX = _minChunkX; chunkX < _maxChunkX; chunkX++, slot++)
+		{
+			Chunk* chunk = _chunks[slot].Chunk.get();
+
+			if (chunk == nullptr) continue;
+
+			for (int i = 0; i < Chunk::TileCount; i++)
+			{
+				TilePosition position = {chunkX * Chunk::Size + (i & (Chunk::Size - 1)), chunkY * Chunk::Size + (i >> Chunk::Shift)};
+
+				if (!visitTile(visitor, chunk->Tiles[i], position)) return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+template<typename Visitor>
+bool Grid::ForEachTile(TilePosition min, TilePosition max, Visitor&& visitor) const
+{
+	TilePosition worldMin = GetMinTilePosition();
+	TilePosition worldMax = GetMaxTilePosition();
+
+	min = {std::max(min.X, worldMin.X), std::max(min.Y, worldMin.Y)};
+	max = {std::min(max.X, worldMax.X - 1), std::min(max.Y, worldMax.Y - 1)};
+
+	for (int chunkY = min.Y >> Chunk::Shift; chunkY <= max.Y >> Chunk::Shift; chunkY++)
+	{
+		for (int chunkX = min.X >> Chunk::Shift; chunkX <= max.X >> Chunk::Shift; chunkX++)
+		{
+			Chunk* chunk = _chunks[getChunkSlot(chunkX, chunkY)].Chunk.get();
+
+			if (chunk == nullptr) continue;
+
+			// The part of the area in the chunk
+			int minX = std::max(min.X - chunkX * Chunk::Size, 0);
+			int maxX = std::min(max.X - chunkX * Chunk::Size, Chunk::Size - 1);
+			int minY = std::max(min.Y - chunkY * Chunk::Size, 0);
+			int maxY = std::min(max.Y - chunkY * Chunk::Size, Chunk::Size - 1);
+
+			for (int y = minY; y <= maxY; y++)
+			{
+				for (int x = minX; x <= maxX; x++)
+				{
+					TilePosition position = {chunkX * Chunk::Size + x, chunkY * Chunk::Size + y};
+
+					if (!visitTile(visitor, chunk->Tiles[x + y * Chunk::Size], position)) return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+template<typename Visitor>
+bool Grid::ForEachTile(TilePosition position, int radius, Visitor&& visitor) const
+{
+	return ForEachTile(position + TilePosition{-radius, -radius}, position + TilePosition{radius, radius}, visitor);
+}
+
+template<typename Visitor>
+bool Grid::ForEachTile(TileQuery query, Visitor&& visitor) const
+{
+	assert((query.Required != 0 || query.AnyOf != 0) && "A query needs at least one required plane");
+
+	int slot = 0;
+
+	for (int chunkY = _minChunkY; chunkY < _maxChunkY; chunkY++)
+	{
+		for (int chunkX = _minChunkX; chunkX < _maxChunkX; chunkX++, slot++)
+		{
+			Chunk* chunk = _chunks[slot].Chunk.get();
+			ChunkPlanes* planes = _chunks[slot].Planes.get();
+
+			if (chunk == nullptr || planes == nullptr) continue;
+
+			for (int y = 0; y < Chunk::Size; y++)
+			{
+				for (uint64_t word = query.Match(*planes, y); word != 0; word &= word - 1)
+				{
+					int x = std::countr_zero(word);
+					TilePosition position = {chunkX * Chunk::Size + x, chunkY * Chunk::Size + y};
+
+					if (!visitTile(visitor, chunk->Tiles[x + y * Chunk::Size], position)) return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+template<typename Visitor>
+void Grid::ForEachNeighbour(TilePosition position, Visitor&& visitor) const
+{
+	for (TilePosition offset : {TilePosition{-1, 0}, TilePosition{1, 0}, TilePosition{0, -1}, TilePosition{0, 1}})
+	{
+		TilePosition neighbour = position + offset;
+
+		if (IsTileValid(neighbour))
+		{
+			visitor(neighbour);
+		}
+	}
+}
+
 
 struct Serializer;
 void Serialize(Serializer* ser, Grid* grid);
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Grid.h"
+
+// Forests and rock fields in clusters shaped by gradient noise.
+// A tile only depends on the seed and its position, so the chunks can be generated in any order and on any thread
+class MapGenerator
+{
+public:
+	explicit MapGenerator(uint64_t seed);
+
+	// Size of the forests and the rock fields, in tiles
+	float ForestScale = 48.f;
+	float RockScale = 14.f;
+	// Noise value above which the forests and the rock fields start, the noise is mostly between -0.5 and 0.5
+	float ForestThreshold = 0.05f;
+	float RockThreshold = 0.3f;
+	// The forests get denser over this range of noise above their threshold
+	float ForestEdge = 0.15f;
+	// Chance to have a tree or a stone on a tile in the middle of a forest or a rock field
+	float ForestDensity = 0.7f;
+	float RockDensity = 0.4f;
+	// Lone trees out of the forests
+	float ScatteredTreeDensity = 0.02f;
+
+	// Nothing grows around the center, the forests only start after twice the radius
+	TilePosition ClearingCenter = {0, 0};
+	float ClearingRadius = 6.f;
+
+	/**
+	 * The tiles of a row of a chunk before anything is built on them, None, a tree or a stone.
+	 * The noise is computed for the whole row, the tiles of a lattice cell share its gradients
+	 * @param types Set to the Chunk::Size tiles of the row, from the left of the chunk
+	 * @param treeGrowths Set to a random growth in seconds for the trees
+	 */
+	void GetRowTiles(int chunkX, int tileY, TileType* types, float* treeGrowths) const;
+
+private:
+	uint64_t _seed;
+
+	// Octaves of gradient noise over the row, each one twice as detailed and half as strong as the previous one
+	void fractalNoiseRow(int firstX, int y, float scale, uint64_t seed, int octaves, float* values) const;
+};
@@ -196,7 +196,7 @@ struct Vector2
 
     constexpr bool operator!=(const Vector2<T> &v) const
     {
-        return *this != v;
+        return !(*this == v);
     }
 
 #pragma endregion Operator Overloads
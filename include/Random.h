@@ -1,26 +1,44 @@
 #pragma once
 
-namespace Random
+#include <cstdint>
+
+// PCG32 generator (XSH RR), 16 bytes of state and a few cycles per number.
+// A stream is a plain value: copy it to replay its numbers, split it to give each chunk, unit or thread its own
+class RandomStream
 {
-    int Range(int min, int max);
-    float Range(float min, float max);
+public:
+    RandomStream() : RandomStream(0) {}
+    explicit RandomStream(uint64_t seed, uint64_t sequence = 0);
 
     /**
-     * Set a seed for the next random numbers
-     * @param newSeed
+     * A stream seeded by the system entropy, for the things that don't need to be reproduced like a new map seed
      */
-    void SetSeed(int newSeed);
+    static RandomStream FromEntropy();
 
-    /**
-     * Use a seed for the next random numbers
-     * @param seed
-     */
-    void UseSeed();
+    uint32_t Next()
+    {
+        uint64_t state = _state;
+        _state = state * 6364136223846793005ULL + _increment;
+
+        auto xorShifted = (uint32_t)(((state >> 18u) ^ state) >> 27u);
+        auto rotation = (uint32_t)(state >> 59u);
+
+        return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31));
+    }
+
+    // Between min and max included
+    int Range(int min, int max);
+    // Between min included and max excluded
+    float Range(float min, float max);
 
     /**
-     * Stop using a seed for the next random numbers
+     * Derive an independent stream from this one and a key without advancing this one,
+     * the same key always gives the same stream so the order the streams are used in doesn't matter
+     * @param key A chunk index, a unit index, a tick...
      */
-    void StopUseSeed();
+    [[nodiscard]] RandomStream Split(uint64_t key) const;
 
-    int GetSeed();
-}
\ No newline at end of file
+private:
+    uint64_t _state;
+    uint64_t _increment;
+};
@@ -7,9 +7,13 @@
 enum SerilizerVersion : int
 {
 	SV_INITIAL = 1,
-	SV_LatestVersion,
+	SV_FlatGrid,
+	SV_ChunkedGrid,
+	SV_TickedTiles,
+	SV_GridSeed,
 	// Don't remove this
-	SV_LatestPlusOne
+	SV_LatestPlusOne,
+	SV_LatestVersion = SV_LatestPlusOne - 1
 };
 
 //Serializer struct 
@@ -18,6 +22,11 @@ struct Serializer
 	int DataVersion;
 	FILE* FilePtr;
 	bool IsWriting = true;
+	// Set when a read or a write couldn't be done entirely
+	bool HasFailed = false;
+	// The flat grid saves count their tiles from the corner of the map, the loaded grid is centered on the tile 0, 0
+	int LegacyTileOffsetX = 0;
+	int LegacyTileOffsetY = 0;
 };
 
 
@@ -25,6 +34,8 @@ void Serialize(Serializer* serializer, void* dataPtr, size_t dataSize);
 
 void Serialize(Serializer* serializer, int32_t* dataPtr);
 
+void Serialize(Serializer* serializer, int64_t* dataPtr);
+
 void Serialize(Serializer* serializer, float* dataPtr);
 
 void Serialize(Serializer* serializer, bool* dataPtr);
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+// Tasks that are waited for together
+class TaskGroup
+{
+public:
+	TaskGroup() = default;
+	TaskGroup(const TaskGroup&) = delete;
+	TaskGroup& operator=(const TaskGroup&) = delete;
+	~TaskGroup() { Wait(); }
+
+	void Run(std::function<void()> task);
+	// Run the queued tasks while the ones of the group are not done, so waiting from a task doesn't block a worker
+	void Wait();
+	[[nodiscard]] bool IsDone() const { return _pendingCount == 0; }
+
+private:
+	std::atomic<int> _pendingCount = 0;
+};
+
+struct TaskSchedulerStats
+{
+	uint64_t TasksRun = 0;
+	// Tasks taken from the deque of another thread
+	uint64_t Steals = 0;
+	// Time the workers slept without work, summed over the workers, in seconds
+	double IdleTime = 0.0;
+};
+
+// Work stealing scheduler. Each thread has its own deque where it pushes and pops its tasks at the back,
+// a thread out of work steals the oldest task at the front of the deque of another thread
+namespace TaskScheduler
+{
+	/**
+	 * Start the worker threads, it's done on the first use with a worker per core besides the calling thread
+	 * @param workerCount 0 for a worker per core besides the calling thread, and at least one
+	 */
+	void Start(int workerCount = 0);
+	// Finish the tasks and join the workers
+	void Stop();
+	// The workers and the calling thread
+	[[nodiscard]] int GetThreadCount();
+
+	/**
+	 * In deterministic mode ParallelFor splits the ranges in blocks of the grain whatever the thread count,
+	 * so the code keying random streams or partial results by block gets the same results on any machine
+	 */
+	void SetDeterministic(bool isDeterministic);
+	[[nodiscard]] bool IsDeterministic();
+
+	/**
+	 * Call the function over blocks of [begin, end) on all the threads and wait for them
+	 * @param grain Size of the blocks in deterministic mode, the smallest block otherwise
+	 */
+	void ParallelFor(int begin, int end, int grain, const std::function<void(int blockBegin, int blockEnd)>& function);
+	// A task per chunk of the rectangle, the max is excluded
+	void ParallelForChunks(int minChunkX, int minChunkY, int maxChunkX, int maxChunkY, const std::function<void(int chunkX, int chunkY)>& function);
+
+	[[nodiscard]] TaskSchedulerStats GetStats();
+	void ResetStats();
+}
+
+// Tasks of a frame and their dependencies, a task starts once the tasks it depends on are done
+class TaskGraph
+{
+public:
+	/**
+	 * @param dependencies Ids of tasks added before
+	 * @return The id of the task
+	 */
+	int Add(std::function<void()> task, std::initializer_list<int> dependencies = {});
+	// Run the tasks, wait for them and clear the graph for the next frame
+	void Run();
+
+private:
+	struct Node
+	{
+		std::function<void()> Task;
+		std::vector<int> Successors;
+		int DependencyCount = 0;
+	};
+
+	std::vector<Node> _nodes;
+};
@@ -55,14 +55,14 @@ enum class Items
 
 struct Texture
 {
-    Texture() = default;
-    explicit Texture(Land land) : TileSheetIndex(TileSheet::Land), TileIndex((int) land) {}
-    explicit Texture(Road road) : TileSheetIndex(TileSheet::Road), TileIndex((int) road) {}
-    explicit Texture(Buildings buildings) : TileSheetIndex(TileSheet::Buildings), TileIndex((int) buildings) {}
-    explicit Texture(Resources ressources) : TileSheetIndex(TileSheet::Ressources), TileIndex((int) ressources) {}
-    explicit Texture(Characters characters) : TileSheetIndex(TileSheet::Characters), TileIndex((int) characters) {}
-    explicit Texture(Icons icons) : TileSheetIndex(TileSheet::Icons), TileIndex((int) icons) {}
-	explicit Texture(Items items) : TileSheetIndex(TileSheet::Icons), TileIndex((int) items) {}
+    constexpr Texture() = default;
+    constexpr explicit Texture(Land land) : TileSheetIndex(TileSheet::Land), TileIndex((int) land) {}
+    constexpr explicit Texture(Road road) : TileSheetIndex(TileSheet::Road), TileIndex((int) road) {}
+    constexpr explicit Texture(Buildings buildings) : TileSheetIndex(TileSheet::Buildings), TileIndex((int) buildings) {}
+    constexpr explicit Texture(Resources ressources) : TileSheetIndex(TileSheet::Ressources), TileIndex((int) ressources) {}
+    constexpr explicit Texture(Characters characters) : TileSheetIndex(TileSheet::Characters), TileIndex((int) characters) {}
+    constexpr explicit Texture(Icons icons) : TileSheetIndex(TileSheet::Icons), TileIndex((int) icons) {}
+	constexpr explicit Texture(Items items) : TileSheetIndex(TileSheet::Icons), TileIndex((int) items) {}
 
     TileSheet TileSheetIndex = TileSheet::None;
     int TileIndex = -1;
@@ -1,7 +1,7 @@
 #pragma once
 
-#include <map>
-#include <string>
+#include <cstdint>
+#include <utility>
 
 #include "Texture.h"
 #include "Serialization.h"
@@ -25,25 +25,30 @@ enum class TileType
     Count
 };
 
-inline std::string TileTypeToString(TileType type)
+// Count of each item, iterated like a map from the item to its count but stored in an array indexed by the item
+class ItemStock
 {
-	switch (type)
+public:
+	ItemStock()
 	{
-		case TileType::None: return "None";
-		case TileType::MayorHouse: return "Mayor House";
-		case TileType::House: return "House";
-		case TileType::BuilderHut: return "Builder Hut";
-		case TileType::Storage: return "Storage";
-		case TileType::Sawmill: return "Sawmill";
-		case TileType::Quarry: return "Quarry";
-		case TileType::LogisticsCenter: return "Logistics Center";
-		case TileType::Furnace: return "Furnace";
-		case TileType::Tree: return "Tree";
-		case TileType::Stone: return "Stone";
-		case TileType::Road: return "Road";
-		default: return "Unknown";
+		for (int i = 0; i < (int)Items::Count; i++)
+		{
+			_items[i] = {(Items)i, 0};
+		}
 	}
-}
+
+	int& at(Items item) { return _items[(int)item].second; }
+	[[nodiscard]] int at(Items item) const { return _items[(int)item].second; }
+	int& operator[](Items item) { return _items[(int)item].second; }
+
+	std::pair<Items, int>* begin() { return _items; }
+	std::pair<Items, int>* end() { return _items + (int)Items::Count; }
+	[[nodiscard]] const std::pair<Items, int>* begin() const { return _items; }
+	[[nodiscard]] const std::pair<Items, int>* end() const { return _items + (int)Items::Count; }
+
+private:
+	std::pair<Items, int> _items[(int)Items::Count];
+};
 
 struct Tile
 {
@@ -54,25 +59,21 @@ struct Tile
 	bool IsBuilt = false;
 	bool NeedToBeDestroyed = false;
 
-    // Tree
-    float TreeGrowth = 0.f;
-	// When it met 30.f, it has a chance to spawn a new tree around it
-	float TreeSpawnTimer = 0.f;
+    // Tree, in simulation ticks, the growth is worked out from the planted tick by the grid
+    int64_t TreePlantedTick = 0;
+	// When it's met, it has a chance to spawn a new tree around it
+	int64_t TreeNextSpawnTick = 0;
 
-    // Furnace
-    float BurnTimer = 0.f; // Use 1 coal to increase it by 30.f
-    float SmeltTimer = 0.f;
+    // Furnace, in simulation ticks, 0 when it's not burning or smelting
+    int64_t BurnEndTick = 0; // Use 1 coal to burn for 30 sec
+    int64_t SmeltEndTick = 0;
+    // Smelting left when the furnace ran out of coal
+    int64_t SmeltTicksLeft = 0;
 
     // Storage
-    std::map<Items, int>* Inventory = new std::map<Items, int>
-	{
-		{ Items::Wood, 0 },
-		{ Items::Stone, 0 },
-		{ Items::Coal, 0 },
-		{ Items::IronOre, 0 },
-		{ Items::IronIngot, 0 }
-	};
+    ItemStock Inventory;
 
+	Tile() = default;
 	Tile(TileType type)
 	{
 		Type = type;
@@ -84,10 +85,13 @@ struct Tile
 		Progress = 0.f;
 		IsBuilt = false;
 		NeedToBeDestroyed = false;
-		TreeGrowth = 0.f;
-		TreeSpawnTimer = 0.f;
+		TreePlantedTick = 0;
+		TreeNextSpawnTick = 0;
+		BurnEndTick = 0;
+		SmeltEndTick = 0;
+		SmeltTicksLeft = 0;
 
-		for (auto& item : *Inventory)
+		for (auto& item : Inventory)
 		{
 			item.second = 0;
 		}
@@ -97,7 +101,7 @@ struct Tile
     {
         int size = 0;
 
-        for (auto& item : *Inventory)
+        for (auto& item : Inventory)
         {
             size += item.second;
         }
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <string>
+
+#include "Tile.h"
+#include "Texture.h"
+
+// Rules of a tile type. The item counts are in the order of Items: wood, stone, coal, iron ore, iron ingot
+struct TileDefinition
+{
+	TileType Type = TileType::None;
+	const char* Name = "";
+
+	// In seconds of work
+	float ConstructionTime = 0.f;
+	float DestructionTime = 0.f;
+
+	int MaxItemsStored[(int)Items::Count] = {};
+	int NeededItemsToBuild[(int)Items::Count] = {};
+	// The logisticians take the items from it and drop them to it
+	bool IsStorage = false;
+
+	// The units with their job on the tile
+	Characters Worker = Characters::Unemployed;
+	int MaxWorkers = 0;
+	int MaxItemsCarried[(int)Items::Count] = {};
+	// Added to the walking speed of the workers
+	float WorkerSpeedFactor = 0.f;
+
+	// The trees, the roads and the furnaces have a texture that depends on their state
+	Texture BaseTexture = {};
+};
+
+// Indexed by TileType
+inline constexpr TileDefinition TileDefinitions[(int)TileType::Count] =
+{
+	{
+		.Type = TileType::None,
+		.Name = "None",
+	},
+	{
+		.Type = TileType::MayorHouse,
+		.Name = "Mayor House",
+		.MaxItemsStored = {15, 15},
+		.IsStorage = true,
+		.BaseTexture = Texture(Buildings::MayorHouse),
+	},
+	{
+		.Type = TileType::House,
+		.Name = "House",
+		.ConstructionTime = 30.f,
+		.DestructionTime = 15.f,
+		.NeededItemsToBuild = {30, 15},
+		.BaseTexture = Texture(Buildings::House),
+	},
+	{
+		.Type = TileType::BuilderHut,
+		.Name = "Builder Hut",
+		.ConstructionTime = 10.f,
+		.DestructionTime = 5.f,
+		.NeededItemsToBuild = {20, 10},
+		.Worker = Characters::Builder,
+		.MaxWorkers = 1,
+		.MaxItemsCarried = {30, 20},
+		.WorkerSpeedFactor = 0.25f,
+		.BaseTexture = Texture(Buildings::BuilderHut),
+	},
+	{
+		.Type = TileType::Storage,
+		.Name = "Storage",
+		.ConstructionTime = 10.f,
+		.DestructionTime = 5.f,
+		.MaxItemsStored = {100, 100, 50, 100, 20},
+		.NeededItemsToBuild = {20},
+		.IsStorage = true,
+		.BaseTexture = Texture(Buildings::Storage),
+	},
+	{
+		.Type = TileType::Sawmill,
+		.Name = "Sawmill",
+		.ConstructionTime = 10.f,
+		.DestructionTime = 5.f,
+		.MaxItemsStored = {50},
+		.NeededItemsToBuild = {10},
+		.Worker = Characters::Lumberjack,
+		.MaxWorkers = 2,
+		.MaxItemsCarried = {30},
+		.BaseTexture = Texture(Buildings::Sawmill),
+	},
+	{
+		.Type = TileType::Quarry,
+		.Name = "Quarry",
+		.ConstructionTime = 15.f,
+		.DestructionTime = 7.5f,
+		.MaxItemsStored = {0, 50, 25, 50},
+		.NeededItemsToBuild = {20},
+		.Worker = Characters::Digger,
+		.MaxWorkers = 2,
+		.WorkerSpeedFactor = -0.5f,
+		.BaseTexture = Texture(Buildings::Quarry),
+	},
+	{
+		.Type = TileType::LogisticsCenter,
+		.Name = "Logistics Center",
+		.ConstructionTime = 10.f,
+		.DestructionTime = 5.f,
+		.MaxItemsStored = {50, 50, 25, 50, 10},
+		.NeededItemsToBuild = {20, 10},
+		.IsStorage = true,
+		.Worker = Characters::Logistician,
+		.MaxWorkers = 1,
+		.MaxItemsCarried = {50, 50, 25, 25, 10},
+		.WorkerSpeedFactor = 0.5f,
+		.BaseTexture = Texture(Buildings::LogisticsCenter),
+	},
+	{
+		.Type = TileType::Furnace,
+		.Name = "Furnace",
+		.ConstructionTime = 15.f,
+		.DestructionTime = 7.5f,
+		.MaxItemsStored = {0, 0, 10, 60, 20},
+		.NeededItemsToBuild = {0, 35},
+		.BaseTexture = Texture(Buildings::InactiveFurnace),
+	},
+	{
+		.Type = TileType::Tree,
+		.Name = "Tree",
+		.DestructionTime = 5.f,
+		.BaseTexture = Texture(Resources::TreeFull),
+	},
+	{
+		.Type = TileType::Stone,
+		.Name = "Stone",
+		.DestructionTime = 10.f,
+		.BaseTexture = Texture(Resources::Stone),
+	},
+	{
+		.Type = TileType::Road,
+		.Name = "Road",
+		.BaseTexture = Texture(Road::Single),
+	},
+};
+
+static_assert([]()
+{
+	for (int i = 0; i < (int)TileType::Count; i++)
+	{
+		if (TileDefinitions[i].Type != (TileType)i) return false;
+	}
+
+	return true;
+}(), "The tile definitions must be in the order of TileType");
+
+constexpr const TileDefinition& GetTileDefinition(TileType type)
+{
+	return TileDefinitions[(int)type];
+}
+
+inline std::string TileTypeToString(TileType type)
+{
+	return (int)type >= 0 && type < TileType::Count ? GetTileDefinition(type).Name : "Unknown";
+}
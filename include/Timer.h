@@ -9,9 +9,22 @@ struct TimerData
 
 namespace Timer
 {
+    // Rate of the simulation, it runs at fixed ticks whatever the frame rate
+    inline constexpr int TicksPerSecond = 30;
+    inline constexpr float TickDuration = 1.f / TicksPerSecond;
+    // Ticks run in one frame at most, after a hitch the simulation slows down instead of trying to catch up forever
+    inline constexpr int MaxTicksPerFrame = 8;
+
     inline float Time = 0.f;
     inline float DeltaTime = 0.f;
     inline float SmoothDeltaTime = 0.f; 
 
+    // Frame time not simulated yet, less than a tick once the ticks of the frame are consumed
+    inline float TickAccumulator = 0.f;
+    // Between 0 and 1, how far the frame is between the last tick and the next one, to interpolate the rendering
+    inline float TickAlpha = 0.f;
+
     void Update();
-}
\ No newline at end of file
+    // Add the frame time to the accumulator and return how many ticks to run this frame
+    int ConsumeTicks();
+}
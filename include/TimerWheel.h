@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct TimerEvent
+{
+	int64_t DueTick;
+	// What the event is about and what it is, up to the owner of the wheel
+	int Target;
+	int Type;
+};
+
+// Hierarchical timer wheel, 4 levels of 64 slots cover 2^24 ticks and the later events wait in an overflow list.
+// Scheduling and firing an event are O(1), advancing a tick only costs the events that are due
+class TimerWheel
+{
+public:
+	static constexpr int SlotBits = 6;
+	static constexpr int SlotCount = 1 << SlotBits;
+	static constexpr int LevelCount = 4;
+
+	void Reset(int64_t tick);
+	// Events already due are fired at the next tick
+	void Schedule(TimerEvent event);
+	// Move to the next tick and add the events due at it to dueEvents
+	void Advance(std::vector<TimerEvent>& dueEvents);
+
+	[[nodiscard]] int64_t GetTick() const { return _tick; }
+	[[nodiscard]] size_t GetEventCount() const { return _eventCount; }
+
+private:
+	int64_t _tick = 0;
+	size_t _eventCount = 0;
+
+	std::vector<TimerEvent> _slots[LevelCount][SlotCount];
+	std::vector<TimerEvent> _overflow;
+
+	void insert(const TimerEvent& event, int64_t minTick);
+	void cascade(std::vector<TimerEvent>& events);
+};
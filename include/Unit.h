@@ -1,6 +1,5 @@
 #pragma once
 
-#include <map>
 #include <vector>
 
 #include "Texture.h"
@@ -20,12 +19,15 @@ struct Unit
 	explicit Unit(Vector2F position)
 	{
 		Position = position;
+		PreviousPosition = position;
 	}
 
     UnitBehavior CurrentBehavior = UnitBehavior::Idle;
 
     int JobTileIndex = -1;
     Vector2F Position {};
+	// Position at the previous tick, the unit is drawn between the two
+	Vector2F PreviousPosition {};
     TilePosition TargetTile {};
 	bool IsInactive = false;
 
@@ -34,15 +36,12 @@ struct Unit
 
     float TimeSinceLastAction = 0.f;
 
+	// Away from the camera the unit doesn't walk, it arrives when the trip would be done
+	float TripTime = 0.f;
+	float TripDuration = 0.f;
+
 	// Inventory
-	std::map<Items, int>* Inventory = new std::map<Items, int>
-	{
-		{ Items::Wood, 0 },
-		{ Items::Stone, 0 },
-		{ Items::Coal, 0 },
-		{ Items::IronOre, 0 },
-		{ Items::IronIngot, 0 }
-	};
+	ItemStock Inventory;
 
     void SetBehavior(UnitBehavior behavior)
     {
@@ -50,6 +49,8 @@ struct Unit
         TimeSinceLastAction = 0.f;
 		PathToTargetTile.clear();
 		CalculatingPath = false;
+		TripTime = 0.f;
+		TripDuration = 0.f;
 
 		if (behavior != UnitBehavior::Idle)
 		{
@@ -1,11 +1,11 @@
 #pragma once
 
 #include <vector>
-#include <map>
 
 #include "Texture.h"
 #include "Unit.h"
 #include "Serialization.h"
+#include "Graphics.h"
 
 class Grid;
 struct TilePosition;
@@ -23,6 +23,13 @@ public:
 
 private:
 	Grid* _grid {};
+	// A unit was added, changed of job or jumped somewhere since the last DrawUnits, or moved during it
+	bool _isRenderDirty = true;
+	// Indexes of the units that asked for a path during the tick, they are found together at the start of the next one
+	// so the paths don't depend on the threads
+	std::vector<int> _pathRequests;
+	// Sprites of each slice of units queued by DrawUnits
+	std::vector<DrawListRange> _drawSlices;
 
 
 	// Unit tick functions
@@ -31,11 +38,22 @@ private:
 	void onTickUnitLogistician(Unit& unit);
 	void OnTickUnitQuarry(Unit& unit);
 
+	void findRequestedPaths();
     void SendInactiveBuildersToBuild();
 	Vector2F GetNextUnitPosition(Unit& unit);
 	Vector2F GetNextTargetPosition(Unit& unit);
 
+	// Trips of the units outside of the detailed chunks
+	bool IsUnitDetailed(Unit& unit);
+	float GetTripDuration(Unit& unit);
+	void TravelCoarse(Unit& unit);
+	void ResumeTrip(Unit& unit);
+
 	Characters GetCharacter(int jobTileIndex);
+	// Like GetCharacter without loading the chunk of the job tile, so the units can be drawn in parallel
+	[[nodiscard]] Characters peekCharacter(int jobTileIndex) const;
+	// Drawn between their previous and current position
+	[[nodiscard]] bool isAnyUnitMoving() const;
 	bool IsTileTakenCareBy(TilePosition position, Characters character);
 	bool IsTileJobFull(int jobTileIndex);
 	int GetMaxUnitOnJob(int jobTileIndex);
@@ -58,12 +76,18 @@ private:
 	int GetMaxItemsFor(Unit& unit, Items item);
 	static bool IsInventoryEmpty(Unit& unit);
     bool IsInventoryHalfFull(Unit& unit);
-	std::map<Items, int> GetAllUsableItems();
+	ItemStock GetAllUsableItems();
     bool HasAtLeastOneItemNeededToBuild(Unit& unit, TilePosition position);
 
 public:
+	// Once per frame, keep the chunks the units are on and going to in memory
+	void PrefetchChunks();
+	// Once per simulation tick
 	void UpdateUnits();
-	void DrawUnits(bool drawBehindBuildings);
+	// Queue the units seen by the camera in the draw list, sorted with the buildings by the bottom of their sprite
+	void DrawUnits();
+	// The units DrawUnits would queue changed since the last DrawUnits, with the same camera
+	[[nodiscard]] bool IsRenderDirty() const;
 
 	void AddUnit(const Unit& unit);
 
@@ -0,0 +1,544 @@
+#pragma once
+/*
+    #version:1# (machine generated, don't edit!)
+
+    Generated by sokol-shdc (https://github.com/floooh/sokol-tools)
+
+    Cmdline: sokol-shdc --input shader/ground-sapp.glsl --output libs/include/ground-sapp.glsl.h --slang hlsl5:glsl330
+
+    Overview:
+
+        Shader program 'ground':
+            Get shader desc: ground_shader_desc(sg_query_backend());
+            Vertex shader: ground_vs
+                Attribute slots:
+                Uniform block 'ground_view':
+                    C struct: ground_view_t
+                    Bind slot: SLOT_ground_view = 0
+            Fragment shader: ground_fs
+                Uniform block 'ground_sheets':
+                    C struct: ground_sheets_t
+                    Bind slot: SLOT_ground_sheets = 0
+                Image 'tiles':
+                    Type: SG_IMAGETYPE_2D
+                    Component Type: SG_SAMPLERTYPE_FLOAT
+                    Bind slot: SLOT_tiles = 0
+                Image 'atlas':
+                    Type: SG_IMAGETYPE_2D
+                    Component Type: SG_SAMPLERTYPE_FLOAT
+                    Bind slot: SLOT_atlas = 1
+
+
+    Shader descriptor structs:
+
+        sg_shader ground = sg_make_shader(ground_shader_desc(sg_query_backend()));
+
+    Image bind slots, use as index in sg_bindings.vs_images[] or .fs_images[]
+
+        SLOT_tiles = 0;
+        SLOT_atlas = 1;
+
+    Bind slot and C-struct for uniform block 'ground_view':
+
+        ground_view_t ground_view = {
+            .view = ...;
+        };
+        sg_apply_uniforms(SG_SHADERSTAGE_[VS|FS], SLOT_ground_view, &SG_RANGE(ground_view));
+
+    Bind slot and C-struct for uniform block 'ground_sheets':
+
+        ground_sheets_t ground_sheets = {
+            .world = ...;
+            .land_cell = ...;
+            .land_origin = ...;
+            .road_cell = ...;
+            .road_origin = ...;
+        };
+        sg_apply_uniforms(SG_SHADERSTAGE_[VS|FS], SLOT_ground_sheets, &SG_RANGE(ground_sheets));
+
+*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stddef.h>
+#if !defined(SOKOL_SHDC_ALIGN)
+  #if defined(_MSC_VER)
+    #define SOKOL_SHDC_ALIGN(a) __declspec(align(a))
+  #else
+    #define SOKOL_SHDC_ALIGN(a) __attribute__((aligned(a)))
+  #endif
+#endif
+#define SLOT_tiles (0)
+#define SLOT_atlas (1)
+#define SLOT_ground_view (0)
+#pragma pack(push,1)
+SOKOL_SHDC_ALIGN(16) typedef struct ground_view_t {
+    float view[4];
+} ground_view_t;
+#pragma pack(pop)
+#define SLOT_ground_sheets (0)
+#pragma pack(push,1)
+SOKOL_SHDC_ALIGN(16) typedef struct ground_sheets_t {
+    float world[4];
+    float land_cell[4];
+    float land_origin[4];
+    float road_cell[4];
+    float road_origin[4];
+} ground_sheets_t;
+#pragma pack(pop)
+/*
+    #version 330
+    
+    uniform vec4 ground_view[1];
+    out vec2 tile;
+    
+    void main()
+    {
+        vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+        gl_Position = vec4((corner.x * 2.0) - 1.0, 1.0 - (corner.y * 2.0), 0.0, 1.0);
+        tile = mix(ground_view[0].xy, ground_view[0].zw, corner);
+    }
+    
+*/
+static const char ground_vs_source_glsl330[294] = {
+    0x23,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x33,0x33,0x30,0x0a,0x0a,0x75,0x6e,
+    0x69,0x66,0x6f,0x72,0x6d,0x20,0x76,0x65,0x63,0x34,0x20,0x67,0x72,0x6f,0x75,0x6e,
+    0x64,0x5f,0x76,0x69,0x65,0x77,0x5b,0x31,0x5d,0x3b,0x0a,0x6f,0x75,0x74,0x20,0x76,
+    0x65,0x63,0x32,0x20,0x74,0x69,0x6c,0x65,0x3b,0x0a,0x0a,0x76,0x6f,0x69,0x64,0x20,
+    0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,
+    0x32,0x20,0x63,0x6f,0x72,0x6e,0x65,0x72,0x20,0x3d,0x20,0x76,0x65,0x63,0x32,0x28,
+    0x66,0x6c,0x6f,0x61,0x74,0x28,0x67,0x6c,0x5f,0x56,0x65,0x72,0x74,0x65,0x78,0x49,
+    0x44,0x20,0x26,0x20,0x31,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x28,0x67,0x6c,
+    0x5f,0x56,0x65,0x72,0x74,0x65,0x78,0x49,0x44,0x20,0x3e,0x3e,0x20,0x31,0x29,0x29,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,
+    0x6e,0x20,0x3d,0x20,0x76,0x65,0x63,0x34,0x28,0x28,0x63,0x6f,0x72,0x6e,0x65,0x72,
+    0x2e,0x78,0x20,0x2a,0x20,0x32,0x2e,0x30,0x29,0x20,0x2d,0x20,0x31,0x2e,0x30,0x2c,
+    0x20,0x31,0x2e,0x30,0x20,0x2d,0x20,0x28,0x63,0x6f,0x72,0x6e,0x65,0x72,0x2e,0x79,
+    0x20,0x2a,0x20,0x32,0x2e,0x30,0x29,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x31,0x2e,
+    0x30,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x74,0x69,0x6c,0x65,0x20,0x3d,0x20,0x6d,
+    0x69,0x78,0x28,0x67,0x72,0x6f,0x75,0x6e,0x64,0x5f,0x76,0x69,0x65,0x77,0x5b,0x30,
+    0x5d,0x2e,0x78,0x79,0x2c,0x20,0x67,0x72,0x6f,0x75,0x6e,0x64,0x5f,0x76,0x69,0x65,
+    0x77,0x5b,0x30,0x5d,0x2e,0x7a,0x77,0x2c,0x20,0x63,0x6f,0x72,0x6e,0x65,0x72,0x29,
+    0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
+};
+/*
+    #version 330
+    
+    uniform vec4 ground_sheets[5];
+    uniform sampler2D tiles;
+    uniform sampler2D atlas;
+    
+    in vec2 tile;
+    layout(location = 0) out vec4 frag_color;
+    
+    void main()
+    {
+        bool _31 = any(lessThan(tile, ground_sheets[0].xy));
+        bool _41;
+        if (!_31)
+        {
+            _41 = any(greaterThanEqual(tile, ground_sheets[0].zw));
+        }
+        else
+        {
+            _41 = _31;
+        }
+        if (_41)
+        {
+            discard;
+        }
+        vec2 _46 = floor(tile);
+        vec2 _66 = floor((texelFetch(tiles, ivec2(mod(_46, vec2(textureSize(tiles, 0)))), 0).xy * 255.0) + vec2(0.5));
+        bool _71 = _66.x > 0.5;
+        vec4 _89 = _71 ? ground_sheets[3] : ground_sheets[1];
+        frag_color = texture(atlas, ((_71 ? ground_sheets[4] : ground_sheets[2]).xy + vec2(_66.y * _89.x, 0.0)) + ((tile - _46) * _89.zw));
+    }
+    
+*/
+static const char ground_fs_source_glsl330[779] = {
+    0x23,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x33,0x33,0x30,0x0a,0x0a,0x75,0x6e,
+    0x69,0x66,0x6f,0x72,0x6d,0x20,0x76,0x65,0x63,0x34,0x20,0x67,0x72,0x6f,0x75,0x6e,
+    0x64,0x5f,0x73,0x68,0x65,0x65,0x74,0x73,0x5b,0x35,0x5d,0x3b,0x0a,0x75,0x6e,0x69,
+    0x66,0x6f,0x72,0x6d,0x20,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x32,0x44,0x20,0x74,
+    0x69,0x6c,0x65,0x73,0x3b,0x0a,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x73,0x61,
+    0x6d,0x70,0x6c,0x65,0x72,0x32,0x44,0x20,0x61,0x74,0x6c,0x61,0x73,0x3b,0x0a,0x0a,
+    0x69,0x6e,0x20,0x76,0x65,0x63,0x32,0x20,0x74,0x69,0x6c,0x65,0x3b,0x0a,0x6c,0x61,
+    0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,
+    0x30,0x29,0x20,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,0x34,0x20,0x66,0x72,0x61,0x67,
+    0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x0a,0x76,0x6f,0x69,0x64,0x20,0x6d,0x61,
+    0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x62,0x6f,0x6f,0x6c,0x20,
+    0x5f,0x33,0x31,0x20,0x3d,0x20,0x61,0x6e,0x79,0x28,0x6c,0x65,0x73,0x73,0x54,0x68,
+    0x61,0x6e,0x28,0x74,0x69,0x6c,0x65,0x2c,0x20,0x67,0x72,0x6f,0x75,0x6e,0x64,0x5f,
+    0x73,0x68,0x65,0x65,0x74,0x73,0x5b,0x30,0x5d,0x2e,0x78,0x79,0x29,0x29,0x3b,0x0a,
+    0x20,0x20,0x20,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x5f,0x34,0x31,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x69,0x66,0x20,0x28,0x21,0x5f,0x33,0x31,0x29,0x0a,0x20,0x20,0x20,0x20,
+    0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x5f,0x34,0x31,0x20,0x3d,0x20,
+    0x61,0x6e,0x79,0x28,0x67,0x72,0x65,0x61,0x74,0x65,0x72,0x54,0x68,0x61,0x6e,0x45,
+    0x71,0x75,0x61,0x6c,0x28,0x74,0x69,0x6c,0x65,0x2c,0x20,0x67,0x72,0x6f,0x75,0x6e,
+    0x64,0x5f,0x73,0x68,0x65,0x65,0x74,0x73,0x5b,0x30,0x5d,0x2e,0x7a,0x77,0x29,0x29,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,0x20,0x20,0x65,0x6c,0x73,0x65,
+    0x0a,0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x5f,
+    0x34,0x31,0x20,0x3d,0x20,0x5f,0x33,0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,
+    0x20,0x20,0x20,0x20,0x69,0x66,0x20,0x28,0x5f,0x34,0x31,0x29,0x0a,0x20,0x20,0x20,
+    0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x64,0x69,0x73,0x63,0x61,
+    0x72,0x64,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,
+    0x63,0x32,0x20,0x5f,0x34,0x36,0x20,0x3d,0x20,0x66,0x6c,0x6f,0x6f,0x72,0x28,0x74,
+    0x69,0x6c,0x65,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x32,0x20,0x5f,
+    0x36,0x36,0x20,0x3d,0x20,0x66,0x6c,0x6f,0x6f,0x72,0x28,0x28,0x74,0x65,0x78,0x65,
+    0x6c,0x46,0x65,0x74,0x63,0x68,0x28,0x74,0x69,0x6c,0x65,0x73,0x2c,0x20,0x69,0x76,
+    0x65,0x63,0x32,0x28,0x6d,0x6f,0x64,0x28,0x5f,0x34,0x36,0x2c,0x20,0x76,0x65,0x63,
+    0x32,0x28,0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x53,0x69,0x7a,0x65,0x28,0x74,0x69,
+    0x6c,0x65,0x73,0x2c,0x20,0x30,0x29,0x29,0x29,0x29,0x2c,0x20,0x30,0x29,0x2e,0x78,
+    0x79,0x20,0x2a,0x20,0x32,0x35,0x35,0x2e,0x30,0x29,0x20,0x2b,0x20,0x76,0x65,0x63,
+    0x32,0x28,0x30,0x2e,0x35,0x29,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x62,0x6f,0x6f,
+    0x6c,0x20,0x5f,0x37,0x31,0x20,0x3d,0x20,0x5f,0x36,0x36,0x2e,0x78,0x20,0x3e,0x20,
+    0x30,0x2e,0x35,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x34,0x20,0x5f,0x38,
+    0x39,0x20,0x3d,0x20,0x5f,0x37,0x31,0x20,0x3f,0x20,0x67,0x72,0x6f,0x75,0x6e,0x64,
+    0x5f,0x73,0x68,0x65,0x65,0x74,0x73,0x5b,0x33,0x5d,0x20,0x3a,0x20,0x67,0x72,0x6f,
+    0x75,0x6e,0x64,0x5f,0x73,0x68,0x65,0x65,0x74,0x73,0x5b,0x31,0x5d,0x3b,0x0a,0x20,
+    0x20,0x20,0x20,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,
+    0x74,0x65,0x78,0x74,0x75,0x72,0x65,0x28,0x61,0x74,0x6c,0x61,0x73,0x2c,0x20,0x28,
+    0x28,0x5f,0x37,0x31,0x20,0x3f,0x20,0x67,0x72,0x6f,0x75,0x6e,0x64,0x5f,0x73,0x68,
+    0x65,0x65,0x74,0x73,0x5b,0x34,0x5d,0x20,0x3a,0x20,0x67,0x72,0x6f,0x75,0x6e,0x64,
+    0x5f,0x73,0x68,0x65,0x65,0x74,0x73,0x5b,0x32,0x5d,0x29,0x2e,0x78,0x79,0x20,0x2b,
+    0x20,0x76,0x65,0x63,0x32,0x28,0x5f,0x36,0x36,0x2e,0x79,0x20,0x2a,0x20,0x5f,0x38,
+    0x39,0x2e,0x78,0x2c,0x20,0x30,0x2e,0x30,0x29,0x29,0x20,0x2b,0x20,0x28,0x28,0x74,
+    0x69,0x6c,0x65,0x20,0x2d,0x20,0x5f,0x34,0x36,0x29,0x20,0x2a,0x20,0x5f,0x38,0x39,
+    0x2e,0x7a,0x77,0x29,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
+};
+/*
+    cbuffer ground_view : register(b0)
+    {
+        float4 _28_view : packoffset(c0);
+    };
+    
+    
+    static float4 gl_Position;
+    static int gl_VertexIndex;
+    static float2 tile;
+    
+    struct SPIRV_Cross_Input
+    {
+        uint gl_VertexIndex : SV_VertexID;
+    };
+    
+    struct SPIRV_Cross_Output
+    {
+        float2 tile : TEXCOORD0;
+        float4 gl_Position : SV_Position;
+    };
+    
+    void vert_main()
+    {
+        float2 corner = float2(float(gl_VertexIndex & 1), float(gl_VertexIndex >> 1));
+        gl_Position = float4((corner.x * 2.0f) - 1.0f, 1.0f - (corner.y * 2.0f), 0.0f, 1.0f);
+        tile = lerp(_28_view.xy, _28_view.zw, corner);
+    }
+    
+    SPIRV_Cross_Output main(SPIRV_Cross_Input stage_input)
+    {
+        gl_VertexIndex = int(stage_input.gl_VertexIndex);
+        vert_main();
+        SPIRV_Cross_Output stage_output;
+        stage_output.gl_Position = gl_Position;
+        stage_output.tile = tile;
+        return stage_output;
+    }
+*/
+static const char ground_vs_source_hlsl5[837] = {
+    0x63,0x62,0x75,0x66,0x66,0x65,0x72,0x20,0x67,0x72,0x6f,0x75,0x6e,0x64,0x5f,0x76,
+    0x69,0x65,0x77,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,0x28,0x62,
+    0x30,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,
+    0x5f,0x32,0x38,0x5f,0x76,0x69,0x65,0x77,0x20,0x3a,0x20,0x70,0x61,0x63,0x6b,0x6f,
+    0x66,0x66,0x73,0x65,0x74,0x28,0x63,0x30,0x29,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x0a,
+    0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x67,0x6c,
+    0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,
+    0x63,0x20,0x69,0x6e,0x74,0x20,0x67,0x6c,0x5f,0x56,0x65,0x72,0x74,0x65,0x78,0x49,
+    0x6e,0x64,0x65,0x78,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x32,0x20,0x74,0x69,0x6c,0x65,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,
+    0x74,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,
+    0x70,0x75,0x74,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x75,0x69,0x6e,0x74,0x20,0x67,
+    0x6c,0x5f,0x56,0x65,0x72,0x74,0x65,0x78,0x49,0x6e,0x64,0x65,0x78,0x20,0x3a,0x20,
+    0x53,0x56,0x5f,0x56,0x65,0x72,0x74,0x65,0x78,0x49,0x44,0x3b,0x0a,0x7d,0x3b,0x0a,
+    0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,
+    0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x0a,0x7b,0x0a,0x20,0x20,0x20,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x74,0x69,0x6c,0x65,0x20,0x3a,0x20,0x54,
+    0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x30,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x34,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,
+    0x20,0x3a,0x20,0x53,0x56,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,
+    0x7d,0x3b,0x0a,0x0a,0x76,0x6f,0x69,0x64,0x20,0x76,0x65,0x72,0x74,0x5f,0x6d,0x61,
+    0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x32,0x20,0x63,0x6f,0x72,0x6e,0x65,0x72,0x20,0x3d,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x32,0x28,0x66,0x6c,0x6f,0x61,0x74,0x28,0x67,0x6c,0x5f,0x56,0x65,0x72,0x74,0x65,
+    0x78,0x49,0x6e,0x64,0x65,0x78,0x20,0x26,0x20,0x31,0x29,0x2c,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x28,0x67,0x6c,0x5f,0x56,0x65,0x72,0x74,0x65,0x78,0x49,0x6e,0x64,0x65,
+    0x78,0x20,0x3e,0x3e,0x20,0x31,0x29,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x67,0x6c,
+    0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x66,0x6c,0x6f,0x61,
+    0x74,0x34,0x28,0x28,0x63,0x6f,0x72,0x6e,0x65,0x72,0x2e,0x78,0x20,0x2a,0x20,0x32,
+    0x2e,0x30,0x66,0x29,0x20,0x2d,0x20,0x31,0x2e,0x30,0x66,0x2c,0x20,0x31,0x2e,0x30,
+    0x66,0x20,0x2d,0x20,0x28,0x63,0x6f,0x72,0x6e,0x65,0x72,0x2e,0x79,0x20,0x2a,0x20,
+    0x32,0x2e,0x30,0x66,0x29,0x2c,0x20,0x30,0x2e,0x30,0x66,0x2c,0x20,0x31,0x2e,0x30,
+    0x66,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x74,0x69,0x6c,0x65,0x20,0x3d,0x20,0x6c,
+    0x65,0x72,0x70,0x28,0x5f,0x32,0x38,0x5f,0x76,0x69,0x65,0x77,0x2e,0x78,0x79,0x2c,
+    0x20,0x5f,0x32,0x38,0x5f,0x76,0x69,0x65,0x77,0x2e,0x7a,0x77,0x2c,0x20,0x63,0x6f,
+    0x72,0x6e,0x65,0x72,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x53,0x50,0x49,0x52,0x56,0x5f,
+    0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x20,0x6d,0x61,0x69,
+    0x6e,0x28,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,
+    0x70,0x75,0x74,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x29,
+    0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x67,0x6c,0x5f,0x56,0x65,0x72,0x74,0x65,0x78,
+    0x49,0x6e,0x64,0x65,0x78,0x20,0x3d,0x20,0x69,0x6e,0x74,0x28,0x73,0x74,0x61,0x67,
+    0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x67,0x6c,0x5f,0x56,0x65,0x72,0x74,0x65,
+    0x78,0x49,0x6e,0x64,0x65,0x78,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x72,
+    0x74,0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x53,0x50,
+    0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,
+    0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,0x0a,0x20,
+    0x20,0x20,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,
+    0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x67,0x6c,
+    0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,
+    0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x74,0x69,0x6c,0x65,
+    0x20,0x3d,0x20,0x74,0x69,0x6c,0x65,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,
+    0x75,0x72,0x6e,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,
+    0x3b,0x0a,0x7d,0x0a,0x00,
+};
+/*
+    cbuffer ground_sheets : register(b0)
+    {
+        float4 _24_world : packoffset(c0);
+        float4 _24_land_cell : packoffset(c1);
+        float4 _24_land_origin : packoffset(c2);
+        float4 _24_road_cell : packoffset(c3);
+        float4 _24_road_origin : packoffset(c4);
+    };
+    
+    Texture2D<float4> tiles : register(t0);
+    SamplerState _tiles_sampler : register(s0);
+    Texture2D<float4> atlas : register(t1);
+    SamplerState _atlas_sampler : register(s1);
+    
+    static float2 tile;
+    static float4 frag_color;
+    
+    struct SPIRV_Cross_Input
+    {
+        float2 tile : TEXCOORD0;
+    };
+    
+    struct SPIRV_Cross_Output
+    {
+        float4 frag_color : SV_Target0;
+    };
+    
+    float2 mod(float2 x, float2 y)
+    {
+        return x - y * floor(x / y);
+    }
+    
+    uint2 spvTextureSize(Texture2D<float4> Tex, uint Level, out uint Param)
+    {
+        uint2 ret;
+        Tex.GetDimensions(Level, ret.x, ret.y, Param);
+        return ret;
+    }
+    
+    void frag_main()
+    {
+        bool _31 = any(tile < _24_world.xy);
+        bool _41;
+        if (!_31)
+        {
+            _41 = any(tile >= _24_world.zw);
+        }
+        else
+        {
+            _41 = _31;
+        }
+        if (_41)
+        {
+            discard;
+        }
+        float2 _46 = floor(tile);
+        uint _57_dummy_parameter;
+        float2 _66 = floor((tiles.Load(int3(int2(mod(_46, float2(int2(spvTextureSize(tiles, uint(0), _57_dummy_parameter))))), 0)).xy * 255.0f) + 0.5f.xx);
+        bool _71 = _66.x > 0.5f;
+        float4 _89 = _71 ? _24_road_cell : _24_land_cell;
+        frag_color = atlas.Sample(_atlas_sampler, ((_71 ? _24_road_origin : _24_land_origin).xy + float2(_66.y * _89.x, 0.0f)) + ((tile - _46) * _89.zw));
+    }
+    
+    SPIRV_Cross_Output main(SPIRV_Cross_Input stage_input)
+    {
+        tile = stage_input.tile;
+        frag_main();
+        SPIRV_Cross_Output stage_output;
+        stage_output.frag_color = frag_color;
+        return stage_output;
+    }
+*/
+static const char ground_fs_source_hlsl5[1712] = {
+    0x63,0x62,0x75,0x66,0x66,0x65,0x72,0x20,0x67,0x72,0x6f,0x75,0x6e,0x64,0x5f,0x73,
+    0x68,0x65,0x65,0x74,0x73,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,
+    0x28,0x62,0x30,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x34,0x20,0x5f,0x32,0x34,0x5f,0x77,0x6f,0x72,0x6c,0x64,0x20,0x3a,0x20,0x70,0x61,
+    0x63,0x6b,0x6f,0x66,0x66,0x73,0x65,0x74,0x28,0x63,0x30,0x29,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x5f,0x32,0x34,0x5f,0x6c,0x61,0x6e,
+    0x64,0x5f,0x63,0x65,0x6c,0x6c,0x20,0x3a,0x20,0x70,0x61,0x63,0x6b,0x6f,0x66,0x66,
+    0x73,0x65,0x74,0x28,0x63,0x31,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x34,0x20,0x5f,0x32,0x34,0x5f,0x6c,0x61,0x6e,0x64,0x5f,0x6f,0x72,0x69,
+    0x67,0x69,0x6e,0x20,0x3a,0x20,0x70,0x61,0x63,0x6b,0x6f,0x66,0x66,0x73,0x65,0x74,
+    0x28,0x63,0x32,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,
+    0x20,0x5f,0x32,0x34,0x5f,0x72,0x6f,0x61,0x64,0x5f,0x63,0x65,0x6c,0x6c,0x20,0x3a,
+    0x20,0x70,0x61,0x63,0x6b,0x6f,0x66,0x66,0x73,0x65,0x74,0x28,0x63,0x33,0x29,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x5f,0x32,0x34,0x5f,
+    0x72,0x6f,0x61,0x64,0x5f,0x6f,0x72,0x69,0x67,0x69,0x6e,0x20,0x3a,0x20,0x70,0x61,
+    0x63,0x6b,0x6f,0x66,0x66,0x73,0x65,0x74,0x28,0x63,0x34,0x29,0x3b,0x0a,0x7d,0x3b,
+    0x0a,0x0a,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,0x3c,0x66,0x6c,0x6f,0x61,
+    0x74,0x34,0x3e,0x20,0x74,0x69,0x6c,0x65,0x73,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,
+    0x73,0x74,0x65,0x72,0x28,0x74,0x30,0x29,0x3b,0x0a,0x53,0x61,0x6d,0x70,0x6c,0x65,
+    0x72,0x53,0x74,0x61,0x74,0x65,0x20,0x5f,0x74,0x69,0x6c,0x65,0x73,0x5f,0x73,0x61,
+    0x6d,0x70,0x6c,0x65,0x72,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,
+    0x28,0x73,0x30,0x29,0x3b,0x0a,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,0x3c,
+    0x66,0x6c,0x6f,0x61,0x74,0x34,0x3e,0x20,0x61,0x74,0x6c,0x61,0x73,0x20,0x3a,0x20,
+    0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,0x28,0x74,0x31,0x29,0x3b,0x0a,0x53,0x61,
+    0x6d,0x70,0x6c,0x65,0x72,0x53,0x74,0x61,0x74,0x65,0x20,0x5f,0x61,0x74,0x6c,0x61,
+    0x73,0x5f,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,
+    0x73,0x74,0x65,0x72,0x28,0x73,0x31,0x29,0x3b,0x0a,0x0a,0x73,0x74,0x61,0x74,0x69,
+    0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x74,0x69,0x6c,0x65,0x3b,0x0a,0x73,
+    0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x66,0x72,0x61,
+    0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,
+    0x20,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,
+    0x75,0x74,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,
+    0x74,0x69,0x6c,0x65,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x30,
+    0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,0x49,
+    0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x0a,
+    0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x66,0x72,0x61,
+    0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3a,0x20,0x53,0x56,0x5f,0x54,0x61,0x72,
+    0x67,0x65,0x74,0x30,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x66,0x6c,0x6f,0x61,0x74,0x32,
+    0x20,0x6d,0x6f,0x64,0x28,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x78,0x2c,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x32,0x20,0x79,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x72,
+    0x65,0x74,0x75,0x72,0x6e,0x20,0x78,0x20,0x2d,0x20,0x79,0x20,0x2a,0x20,0x66,0x6c,
+    0x6f,0x6f,0x72,0x28,0x78,0x20,0x2f,0x20,0x79,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x75,
+    0x69,0x6e,0x74,0x32,0x20,0x73,0x70,0x76,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x53,
+    0x69,0x7a,0x65,0x28,0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,0x3c,0x66,0x6c,
+    0x6f,0x61,0x74,0x34,0x3e,0x20,0x54,0x65,0x78,0x2c,0x20,0x75,0x69,0x6e,0x74,0x20,
+    0x4c,0x65,0x76,0x65,0x6c,0x2c,0x20,0x6f,0x75,0x74,0x20,0x75,0x69,0x6e,0x74,0x20,
+    0x50,0x61,0x72,0x61,0x6d,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x75,0x69,0x6e,
+    0x74,0x32,0x20,0x72,0x65,0x74,0x3b,0x0a,0x20,0x20,0x20,0x20,0x54,0x65,0x78,0x2e,
+    0x47,0x65,0x74,0x44,0x69,0x6d,0x65,0x6e,0x73,0x69,0x6f,0x6e,0x73,0x28,0x4c,0x65,
+    0x76,0x65,0x6c,0x2c,0x20,0x72,0x65,0x74,0x2e,0x78,0x2c,0x20,0x72,0x65,0x74,0x2e,
+    0x79,0x2c,0x20,0x50,0x61,0x72,0x61,0x6d,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,
+    0x65,0x74,0x75,0x72,0x6e,0x20,0x72,0x65,0x74,0x3b,0x0a,0x7d,0x0a,0x0a,0x76,0x6f,
+    0x69,0x64,0x20,0x66,0x72,0x61,0x67,0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,
+    0x0a,0x20,0x20,0x20,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x5f,0x33,0x31,0x20,0x3d,0x20,
+    0x61,0x6e,0x79,0x28,0x74,0x69,0x6c,0x65,0x20,0x3c,0x20,0x5f,0x32,0x34,0x5f,0x77,
+    0x6f,0x72,0x6c,0x64,0x2e,0x78,0x79,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x62,0x6f,
+    0x6f,0x6c,0x20,0x5f,0x34,0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x66,0x20,0x28,
+    0x21,0x5f,0x33,0x31,0x29,0x0a,0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x5f,0x34,0x31,0x20,0x3d,0x20,0x61,0x6e,0x79,0x28,0x74,0x69,
+    0x6c,0x65,0x20,0x3e,0x3d,0x20,0x5f,0x32,0x34,0x5f,0x77,0x6f,0x72,0x6c,0x64,0x2e,
+    0x7a,0x77,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,0x20,0x20,0x65,
+    0x6c,0x73,0x65,0x0a,0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,
+    0x20,0x20,0x5f,0x34,0x31,0x20,0x3d,0x20,0x5f,0x33,0x31,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x7d,0x0a,0x20,0x20,0x20,0x20,0x69,0x66,0x20,0x28,0x5f,0x34,0x31,0x29,0x0a,
+    0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x64,0x69,
+    0x73,0x63,0x61,0x72,0x64,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,0x20,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x5f,0x34,0x36,0x20,0x3d,0x20,0x66,0x6c,
+    0x6f,0x6f,0x72,0x28,0x74,0x69,0x6c,0x65,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x75,
+    0x69,0x6e,0x74,0x20,0x5f,0x35,0x37,0x5f,0x64,0x75,0x6d,0x6d,0x79,0x5f,0x70,0x61,
+    0x72,0x61,0x6d,0x65,0x74,0x65,0x72,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x32,0x20,0x5f,0x36,0x36,0x20,0x3d,0x20,0x66,0x6c,0x6f,0x6f,0x72,0x28,
+    0x28,0x74,0x69,0x6c,0x65,0x73,0x2e,0x4c,0x6f,0x61,0x64,0x28,0x69,0x6e,0x74,0x33,
+    0x28,0x69,0x6e,0x74,0x32,0x28,0x6d,0x6f,0x64,0x28,0x5f,0x34,0x36,0x2c,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x32,0x28,0x69,0x6e,0x74,0x32,0x28,0x73,0x70,0x76,0x54,0x65,
+    0x78,0x74,0x75,0x72,0x65,0x53,0x69,0x7a,0x65,0x28,0x74,0x69,0x6c,0x65,0x73,0x2c,
+    0x20,0x75,0x69,0x6e,0x74,0x28,0x30,0x29,0x2c,0x20,0x5f,0x35,0x37,0x5f,0x64,0x75,
+    0x6d,0x6d,0x79,0x5f,0x70,0x61,0x72,0x61,0x6d,0x65,0x74,0x65,0x72,0x29,0x29,0x29,
+    0x29,0x29,0x2c,0x20,0x30,0x29,0x29,0x2e,0x78,0x79,0x20,0x2a,0x20,0x32,0x35,0x35,
+    0x2e,0x30,0x66,0x29,0x20,0x2b,0x20,0x30,0x2e,0x35,0x66,0x2e,0x78,0x78,0x29,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x62,0x6f,0x6f,0x6c,0x20,0x5f,0x37,0x31,0x20,0x3d,0x20,
+    0x5f,0x36,0x36,0x2e,0x78,0x20,0x3e,0x20,0x30,0x2e,0x35,0x66,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x5f,0x38,0x39,0x20,0x3d,0x20,0x5f,
+    0x37,0x31,0x20,0x3f,0x20,0x5f,0x32,0x34,0x5f,0x72,0x6f,0x61,0x64,0x5f,0x63,0x65,
+    0x6c,0x6c,0x20,0x3a,0x20,0x5f,0x32,0x34,0x5f,0x6c,0x61,0x6e,0x64,0x5f,0x63,0x65,
+    0x6c,0x6c,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,
+    0x6f,0x72,0x20,0x3d,0x20,0x61,0x74,0x6c,0x61,0x73,0x2e,0x53,0x61,0x6d,0x70,0x6c,
+    0x65,0x28,0x5f,0x61,0x74,0x6c,0x61,0x73,0x5f,0x73,0x61,0x6d,0x70,0x6c,0x65,0x72,
+    0x2c,0x20,0x28,0x28,0x5f,0x37,0x31,0x20,0x3f,0x20,0x5f,0x32,0x34,0x5f,0x72,0x6f,
+    0x61,0x64,0x5f,0x6f,0x72,0x69,0x67,0x69,0x6e,0x20,0x3a,0x20,0x5f,0x32,0x34,0x5f,
+    0x6c,0x61,0x6e,0x64,0x5f,0x6f,0x72,0x69,0x67,0x69,0x6e,0x29,0x2e,0x78,0x79,0x20,
+    0x2b,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,0x5f,0x36,0x36,0x2e,0x79,0x20,0x2a,
+    0x20,0x5f,0x38,0x39,0x2e,0x78,0x2c,0x20,0x30,0x2e,0x30,0x66,0x29,0x29,0x20,0x2b,
+    0x20,0x28,0x28,0x74,0x69,0x6c,0x65,0x20,0x2d,0x20,0x5f,0x34,0x36,0x29,0x20,0x2a,
+    0x20,0x5f,0x38,0x39,0x2e,0x7a,0x77,0x29,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x53,0x50,
+    0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,
+    0x20,0x6d,0x61,0x69,0x6e,0x28,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,
+    0x73,0x5f,0x49,0x6e,0x70,0x75,0x74,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,
+    0x70,0x75,0x74,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x74,0x69,0x6c,0x65,0x20,
+    0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x74,0x69,
+    0x6c,0x65,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x72,0x61,0x67,0x5f,0x6d,0x61,0x69,
+    0x6e,0x28,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,
+    0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x20,0x73,0x74,0x61,0x67,
+    0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x74,
+    0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x66,0x72,0x61,0x67,0x5f,
+    0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,
+    0x6f,0x72,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x73,
+    0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,0x0a,0x7d,0x0a,0x00,
+};
+#if !defined(SOKOL_GFX_INCLUDED)
+  #error "Please include sokol_gfx.h before ground-sapp.glsl.h"
+#endif
+static inline const sg_shader_desc* ground_shader_desc(sg_backend backend) {
+  if (backend == SG_BACKEND_GLCORE33) {
+    static sg_shader_desc desc;
+    static bool valid;
+    if (!valid) {
+      valid = true;
+      desc.vs.source = ground_vs_source_glsl330;
+      desc.vs.entry = "main";
+      desc.vs.uniform_blocks[0].size = 16;
+      desc.vs.uniform_blocks[0].layout = SG_UNIFORMLAYOUT_STD140;
+      desc.vs.uniform_blocks[0].uniforms[0].name = "ground_view";
+      desc.vs.uniform_blocks[0].uniforms[0].type = SG_UNIFORMTYPE_FLOAT4;
+      desc.vs.uniform_blocks[0].uniforms[0].array_count = 1;
+      desc.fs.source = ground_fs_source_glsl330;
+      desc.fs.entry = "main";
+      desc.fs.uniform_blocks[0].size = 80;
+      desc.fs.uniform_blocks[0].layout = SG_UNIFORMLAYOUT_STD140;
+      desc.fs.uniform_blocks[0].uniforms[0].name = "ground_sheets";
+      desc.fs.uniform_blocks[0].uniforms[0].type = SG_UNIFORMTYPE_FLOAT4;
+      desc.fs.uniform_blocks[0].uniforms[0].array_count = 5;
+      desc.fs.images[0].name = "tiles";
+      desc.fs.images[0].image_type = SG_IMAGETYPE_2D;
+      desc.fs.images[0].sampler_type = SG_SAMPLERTYPE_FLOAT;
+      desc.fs.images[1].name = "atlas";
+      desc.fs.images[1].image_type = SG_IMAGETYPE_2D;
+      desc.fs.images[1].sampler_type = SG_SAMPLERTYPE_FLOAT;
+      desc.label = "ground_shader";
+    }
+    return &desc;
+  }
+  if (backend == SG_BACKEND_D3D11) {
+    static sg_shader_desc desc;
+    static bool valid;
+    if (!valid) {
+      valid = true;
+      desc.vs.source = ground_vs_source_hlsl5;
+      desc.vs.d3d11_target = "vs_5_0";
+      desc.vs.entry = "main";
+      desc.vs.uniform_blocks[0].size = 16;
+      desc.vs.uniform_blocks[0].layout = SG_UNIFORMLAYOUT_STD140;
+      desc.fs.source = ground_fs_source_hlsl5;
+      desc.fs.d3d11_target = "ps_5_0";
+      desc.fs.entry = "main";
+      desc.fs.uniform_blocks[0].size = 80;
+      desc.fs.uniform_blocks[0].layout = SG_UNIFORMLAYOUT_STD140;
+      desc.fs.images[0].name = "tiles";
+      desc.fs.images[0].image_type = SG_IMAGETYPE_2D;
+      desc.fs.images[0].sampler_type = SG_SAMPLERTYPE_FLOAT;
+      desc.fs.images[1].name = "atlas";
+      desc.fs.images[1].image_type = SG_IMAGETYPE_2D;
+      desc.fs.images[1].sampler_type = SG_SAMPLERTYPE_FLOAT;
+      desc.label = "ground_shader";
+    }
+    return &desc;
+  }
+  return 0;
+}
@@ -4,21 +4,29 @@ uniform vs_window
     vec4 screen_size;
 };
 
-in vec4 position;
+in vec2 position;
 in vec4 color0;
+// Normalized, the lowest bit of u tells if the vertex is textured and the 15 others are the coordinate
 in vec2 uv0;
-in float frame0;
 
 out vec4 color;
 out vec2 uv;
 
 void main()
 {
-	if (frame0 != screen_size.z) return;
-
-    gl_Position = ((position * vec4(2, 2, 1, 1)) / vec4(screen_size.x, screen_size.y, 1, 1) - vec4(1, 1, 0, 0)) * vec4(1, -1, 1, 1);
+    gl_Position = vec4(position.x * 2 / screen_size.x - 1, 1 - position.y * 2 / screen_size.y, 0, 1);
     color = color0;
-    uv = uv0;
+
+    float u = floor(uv0.x * 65535 + 0.5);
+
+    if (mod(u, 2) > 0.5)
+    {
+        uv = vec2(floor(u / 2) / 32767, uv0.y);
+    }
+    else
+    {
+        uv = vec2(-1, -1);
+    }
 }
 #pragma sokol @end
 
@@ -0,0 +1,57 @@
+#pragma sokol @vs ground_vs
+uniform ground_view
+{
+    // Tile coordinates of the top left corner of the screen, then of the bottom right one
+    vec4 view;
+};
+
+out vec2 tile;
+
+void main()
+{
+    // A quad covering the screen, drawn as a triangle strip of 4 vertices without vertex buffer
+    vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+
+    gl_Position = vec4(corner.x * 2 - 1, 1 - corner.y * 2, 0, 1);
+    tile = mix(view.xy, view.zw, corner);
+}
+#pragma sokol @end
+
+#pragma sokol @fs ground_fs
+uniform ground_sheets
+{
+    // World bounds in tiles, the max is excluded
+    vec4 world;
+    // Distance between 2 sprites of the sheet in x, then the size of the sampled part of a sprite
+    vec4 land_cell;
+    // Top left corner of the first sprite of the sheet
+    vec4 land_origin;
+    vec4 road_cell;
+    vec4 road_origin;
+};
+
+// Sheet and sprite index of each tile, the tiles wrap around the texture
+uniform sampler2D tiles;
+uniform sampler2D atlas;
+
+in vec2 tile;
+
+out vec4 frag_color;
+
+void main()
+{
+    if (any(lessThan(tile, world.xy)) || any(greaterThanEqual(tile, world.zw))) discard;
+
+    vec2 cell = floor(tile);
+    ivec2 texel = ivec2(mod(cell, vec2(textureSize(tiles, 0))));
+    vec2 sprite = floor(texelFetch(tiles, texel, 0).xy * 255 + 0.5);
+
+    bool isRoad = sprite.x > 0.5;
+    vec4 sheet_cell = isRoad ? road_cell : land_cell;
+    vec4 sheet_origin = isRoad ? road_origin : land_origin;
+
+    frag_color = texture(atlas, sheet_origin.xy + vec2(sprite.y * sheet_cell.x, 0) + (tile - cell) * sheet_cell.zw);
+}
+#pragma sokol @end
+
+#pragma sokol @program ground ground_vs ground_fs
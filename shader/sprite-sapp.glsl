@@ -0,0 +1,65 @@
+#pragma sokol @vs sprite_vs
+uniform sprite_view
+{
+    vec4 screen_size;
+    // World to screen transformation, a row of the 2x3 matrix in each
+    vec4 transform[2];
+    // Distance between 2 sprites of each sheet in x, then the size of the sampled part of a sprite
+    vec4 sheet_cells[6];
+    // Top left corner of the first sprite of each sheet
+    vec4 sheet_origins[6];
+};
+
+// A quad by instance, the 4 vertexes are made from the vertex indexes
+in vec2 position;
+in vec2 size;
+// Sheet and sprite index in the sheet, the sheet is 255 for a flat color
+in vec4 sprite;
+in vec4 color0;
+
+out vec4 color;
+out vec2 uv;
+
+void main()
+{
+    vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+    vec3 world = vec3(position + corner * size, 1);
+    vec2 screen = vec2(dot(transform[0].xyz, world), dot(transform[1].xyz, world));
+
+    gl_Position = vec4(screen.x * 2 / screen_size.x - 1, 1 - screen.y * 2 / screen_size.y, 0, 1);
+    color = color0;
+
+    if (sprite.x > 254.5)
+    {
+        uv = vec2(-1, -1);
+    }
+    else
+    {
+        int sheet = int(sprite.x + 0.5);
+        uv = sheet_origins[sheet].xy + vec2(sprite.y * sheet_cells[sheet].x, 0) + corner * sheet_cells[sheet].zw;
+    }
+}
+#pragma sokol @end
+
+#pragma sokol @fs sprite_fs
+uniform sampler2D sprite_tex;
+
+in vec4 color;
+in vec2 uv;
+
+out vec4 frag_color;
+
+void main()
+{
+    if (uv == vec2(-1, -1))
+    {
+        frag_color = color;
+    }
+    else
+    {
+        frag_color = texture(sprite_tex, uv) * color;
+    }
+}
+#pragma sokol @end
+
+#pragma sokol @program sprite sprite_vs sprite_fs
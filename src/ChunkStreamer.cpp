@@ -0,0 +1,197 @@
+#include "ChunkStreamer.h"
+
+#include <cassert>
+
+#include "Grid.h"
+#include "Serialization.h"
+#include "Logger.h"
+
+// What Serialize(Tile) writes: the type, the progress, 2 bools, 5 ticks and the inventory, serializeRecord checks it
+const int64_t ChunkStreamer::RecordSize = Chunk::TileCount * (int64_t)(sizeof(int) + sizeof(float) + 2 * sizeof(bool) + 5 * sizeof(int64_t) + (int)Items::Count * sizeof(int));
+
+// The chunk file can grow past 2 GB, where long is 32 bits on Windows
+static int seekFile(FILE* file, int64_t offset)
+{
+#if defined(_WIN32)
+	return _fseeki64(file, offset, SEEK_SET);
+#else
+	return fseeko(file, (off_t)offset, SEEK_SET);
+#endif
+}
+
+static int64_t tellFile(FILE* file)
+{
+#if defined(_WIN32)
+	return _ftelli64(file);
+#else
+	return (int64_t)ftello(file);
+#endif
+}
+
+ChunkStreamer::ChunkStreamer(const char* filePath)
+{
+	_file = fopen(filePath, "w+b");
+
+	if (_file == nullptr)
+	{
+		LOG_ERROR("Can't open the chunk file " << filePath);
+	}
+
+	_thread = std::thread(&ChunkStreamer::run, this);
+}
+
+ChunkStreamer::~ChunkStreamer()
+{
+	{
+		std::lock_guard lock(_mutex);
+		_isStopping = true;
+	}
+
+	_jobAdded.notify_one();
+	_thread.join();
+
+	for (auto& loaded : _loaded)
+	{
+		delete loaded.Chunk;
+	}
+
+	if (_file != nullptr)
+	{
+		fclose(_file);
+	}
+}
+
+void ChunkStreamer::Write(int chunkX, int chunkY, Chunk* chunk, int64_t record)
+{
+	{
+		std::lock_guard lock(_mutex);
+		_jobs.push_back({chunk, chunkX, chunkY, record});
+	}
+
+	_jobAdded.notify_one();
+}
+
+void ChunkStreamer::Read(int chunkX, int chunkY, int64_t record)
+{
+	{
+		std::lock_guard lock(_mutex);
+		_jobs.push_back({nullptr, chunkX, chunkY, record});
+	}
+
+	_jobAdded.notify_one();
+}
+
+bool ChunkStreamer::PopLoaded(int& chunkX, int& chunkY, Chunk*& chunk)
+{
+	std::lock_guard lock(_mutex);
+
+	if (_loaded.empty()) return false;
+
+	chunkX = _loaded.front().ChunkX;
+	chunkY = _loaded.front().ChunkY;
+	chunk = _loaded.front().Chunk;
+	_loaded.pop_front();
+
+	return true;
+}
+
+void ChunkStreamer::Flush()
+{
+	std::unique_lock lock(_mutex);
+
+	_jobsDone.wait(lock, [this]() { return _jobs.empty() && !_isBusy; });
+}
+
+Chunk* ChunkStreamer::ReadNow(int64_t record)
+{
+	Chunk* chunk = new Chunk();
+
+	// Nothing else has the tiles, what could be read is kept
+	if (!serializeRecord(chunk, record, false))
+	{
+		LOG_ERROR("Can't read the chunk record " << record);
+	}
+
+	return chunk;
+}
+
+void ChunkStreamer::Clear()
+{
+	_recordCount = 0;
+}
+
+void ChunkStreamer::run()
+{
+	std::unique_lock lock(_mutex);
+
+	while (true)
+	{
+		_jobAdded.wait(lock, [this]() { return _isStopping || !_jobs.empty(); });
+
+		if (_jobs.empty()) return;
+
+		Job job = _jobs.front();
+		_jobs.pop_front();
+		_isBusy = true;
+
+		lock.unlock();
+
+		bool isLoaded = true;
+
+		if (job.Chunk == nullptr)
+		{
+			job.Chunk = ReadNow(job.Record);
+		}
+		else if (serializeRecord(job.Chunk, job.Record, true))
+		{
+			delete job.Chunk;
+			isLoaded = false;
+		}
+		else
+		{
+			// Give the chunk back instead of losing its tiles
+			LOG_ERROR("Can't write the chunk record " << job.Record);
+		}
+
+		lock.lock();
+
+		if (isLoaded)
+		{
+			_loaded.push_back({job.Chunk, job.ChunkX, job.ChunkY});
+		}
+
+		_isBusy = false;
+
+		if (_jobs.empty())
+		{
+			_jobsDone.notify_all();
+		}
+	}
+}
+
+bool ChunkStreamer::serializeRecord(Chunk* chunk, int64_t record, bool isWriting)
+{
+	if (_file == nullptr || seekFile(_file, record) != 0)
+	{
+		_hasFailed = true;
+		return false;
+	}
+
+	Serializer serializer = {SV_LatestVersion, _file, isWriting};
+
+	for (auto& tile : chunk->Tiles)
+	{
+		Serialize(&serializer, &tile);
+	}
+
+	assert((!isWriting || serializer.HasFailed || tellFile(_file) == record + RecordSize) && "RecordSize doesn't match Serialize(Tile)");
+
+	// Reads and writes on the same file need a seek in between
+	if (serializer.HasFailed || fflush(_file) != 0)
+	{
+		_hasFailed = true;
+		return false;
+	}
+
+	return true;
+}
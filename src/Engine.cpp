@@ -10,6 +10,8 @@
 #include "util/sokol_imgui.h"
 
 #include "basic-sapp.glsl.h"
+#include "ground-sapp.glsl.h"
+#include "sprite-sapp.glsl.h"
 
 #include "Audio.h"
 #include "Constants.h"
@@ -30,27 +32,52 @@
     #pragma comment(lib, "Shlwapi.lib") // Link to the Shlwapi library
 #endif
 
+#include <algorithm>
+#include <chrono>
+#include <thread>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 
 struct vs_window
 {
     float width;
     float height;
-    float frame, pad1;
+    float pad0, pad1;
 };
 
 static struct
 {
     sg_pipeline pip;
     sg_bindings bind;
+    // Tilemap pass of the ground, drawn before the other sprites
+    sg_pipeline groundPip;
+    sg_bindings groundBind;
+    // Instanced sprites, the quads are made in the vertex shader
+    sg_pipeline spritePip;
+    sg_bindings spriteBind;
+    sprite_view_t spriteView;
+    // Sizes in bytes of the dynamic buffers, they grow with the biggest frame
+    size_t vertexCapacity;
+    size_t indexCapacity;
+    size_t instanceCapacity;
     sg_pass_action pass_action;
     vs_window vs_window;
 } state;
 
 // ====== Imgui =========
 
+// Frames per second while the window isn't focused, 0 to not limit them. Set with --idle-fps
+static int idleFramesPerSecond = 10;
+// Chunks kept in memory, the others are paged out to a file of the temporary directory. 0 keeps them all in memory. Set with --resident-chunks
+static int residentChunkBudget = 0;
+// Starting width and height of the world in tiles, 0 for the default of the game. Set with --map-size
+static int mapSize = 0;
+static bool isWindowFocused = true;
+static std::chrono::steady_clock::time_point lastFrameStart;
+
 static bool show_test_window = true;
 static bool show_another_window = false;
 
@@ -60,8 +87,9 @@ static bool show_another_window = false;
 
 static void (*DLL_OnLoad)  (Image*, FrameData*, ImGuiData*, ImTextureID*) = nullptr;
 static void (*DLL_OnInput) (const sapp_event*) = nullptr;
-static void (*DLL_InitGame)(void*, Image*, FrameData*, ImGuiData*, ImTextureID*) = nullptr;
+static void (*DLL_InitGame)(void*, Image*, FrameData*, ImGuiData*, ImTextureID*, int, int) = nullptr;
 static void (*DLL_OnFrame) (void*, FrameData*, TimerData*, const simgui_frame_desc_t*) = nullptr;
+static void (*DLL_FastForwardHeadless)(void*, float, const char*) = nullptr;
 
 void* gameStateMemory = nullptr;
 
@@ -78,12 +106,19 @@ TimerData timerData = {};
 
 auto mainTheme = Audio::loadSoundClip("assets/mainTheme.wav");
 
-void InitGame(void* gameMemory, Image* tilemap, FrameData* frameData, ImGuiData* engineImGuiData, ImTextureID* imTextureID);
+void InitGame(void* gameMemory, Image* tilemap, FrameData* frameData, ImGuiData* engineImGuiData, ImTextureID* imTextureID, int residentChunkBudget, int mapSize);
 
 void OnFrame(FrameData* frameData, TimerData* timerData, const simgui_frame_desc_t* simgui_frame_desc);
 
+void FastForwardHeadless(void* gameMemory, float gameTime, const char* saveFileName);
+
 void RunnerOnEvent(const sapp_event* event)
 {
+    if (event->type == SAPP_EVENTTYPE_FOCUSED || event->type == SAPP_EVENTTYPE_UNFOCUSED)
+    {
+        isWindowFocused = event->type == SAPP_EVENTTYPE_FOCUSED;
+    }
+
     if (DLL_OnInput) DLL_OnInput(event);
     else Input::OnInput(event);
 
@@ -138,12 +173,15 @@ void LoadDLL()
         DLL_OnInput = (void (*)(const sapp_event*))Platform::GetSymbol(libHandle, "DLL_OnInput"); 
         assert(DLL_OnInput != NULL && "Couldn't find function DLL_OnInput in Game.dll");
 
-        DLL_InitGame = (void (*)(void*, Image*, FrameData*, ImGuiData*, ImTextureID*))Platform::GetSymbol(libHandle, "DLL_InitGame"); 
+        DLL_InitGame = (void (*)(void*, Image*, FrameData*, ImGuiData*, ImTextureID*, int, int))Platform::GetSymbol(libHandle, "DLL_InitGame"); 
         assert(DLL_InitGame != NULL && "Couldn't find function DLL_InitGame in Game.dll");
 
         DLL_OnFrame  = (void (*)(void*, FrameData*, TimerData*, const simgui_frame_desc_t*))Platform::GetSymbol(libHandle, "DLL_OnFrame"); 
         assert(DLL_OnFrame != NULL && "Couldn't find function DLL_OnFrame in Game.dll");
 
+        DLL_FastForwardHeadless = (void (*)(void*, float, const char*))Platform::GetSymbol(libHandle, "DLL_FastForwardHeadless"); 
+        assert(DLL_FastForwardHeadless != NULL && "Couldn't find function DLL_FastForwardHeadless in Game.dll");
+
         if (DLL_OnLoad) DLL_OnLoad(&tilemap, &frameData, &imguiData, &imTextureID);
     }
 }
@@ -154,6 +192,27 @@ void LoadDLL()
 
 #pragma region SokolFunctions
 
+// Make a dynamic buffer again when a frame needs more than it holds, at least twice as big so it's rarely made again
+static void fitBuffer(sg_buffer& buffer, size_t& capacity, size_t size, sg_buffer_type type, const char* label)
+{
+    if (buffer.id != SG_INVALID_ID && size <= capacity) return;
+
+    capacity = std::max(size, capacity * 2);
+
+    if (buffer.id != SG_INVALID_ID)
+    {
+        sg_destroy_buffer(buffer);
+        LOG("Growing " << label << " to " << capacity << " bytes");
+    }
+
+    buffer = sg_make_buffer((sg_buffer_desc){
+        .size = capacity,
+        .type = type,
+        .usage = SG_USAGE_DYNAMIC,
+        .label = label,
+    });
+}
+
 static void init()
 { 
     frameData.screenSize   = Vector2F{sapp_widthf(), sapp_heightf()};
@@ -168,20 +227,10 @@ static void init()
         .context = sapp_sgcontext()};
     sg_setup(desc);
 
-    state.vs_window = {sapp_widthf(), sapp_heightf(), 0};
+    state.vs_window = {sapp_widthf(), sapp_heightf()};
 
-    state.bind.vertex_buffers[0] = sg_make_buffer((sg_buffer_desc){
-        .size = Graphics::maxVertexes * sizeof(frameData.vertexBufferPtr[0]),
-        .usage = SG_USAGE_DYNAMIC,
-        .label = "triangle-vertices",
-    });
-
-    state.bind.index_buffer = sg_make_buffer((sg_buffer_desc){
-        .size = Graphics::maxVertexes * sizeof(frameData.indexBufferPtr[0]),
-        .type = SG_BUFFERTYPE_INDEXBUFFER,
-        .usage = SG_USAGE_DYNAMIC,
-        .label = "triangle-indices",
-    });
+    fitBuffer(state.bind.vertex_buffers[0], state.vertexCapacity, Graphics::startBufferCapacity * sizeof(PackedVertex), SG_BUFFERTYPE_VERTEXBUFFER, "triangle-vertices");
+    fitBuffer(state.bind.index_buffer, state.indexCapacity, Graphics::startBufferCapacity * sizeof(uint32_t), SG_BUFFERTYPE_INDEXBUFFER, "triangle-indices");
 
     state.bind.fs_images[SLOT_tex] = sg_make_image((sg_image_desc){
         .width  = tilemap.GetWidth(),
@@ -200,10 +249,9 @@ static void init()
         {
             .attrs =
             {
-                {.format = SG_VERTEXFORMAT_FLOAT3},
-                {.format = SG_VERTEXFORMAT_FLOAT4},
                 {.format = SG_VERTEXFORMAT_FLOAT2},
-				{.format = SG_VERTEXFORMAT_FLOAT},
+                {.format = SG_VERTEXFORMAT_UBYTE4N},
+                {.format = SG_VERTEXFORMAT_USHORT2N},
 			}
 		},
         .colors =
@@ -226,6 +274,47 @@ static void init()
     };
     state.pip = sg_make_pipeline(pip_desc);
 
+    fitBuffer(state.spriteBind.vertex_buffers[0], state.instanceCapacity, Graphics::startBufferCapacity * sizeof(SpriteInstance), SG_BUFFERTYPE_VERTEXBUFFER, "sprite-instances");
+    state.spriteBind.fs_images[SLOT_sprite_tex] = state.bind.fs_images[SLOT_tex];
+
+    sg_pipeline_desc sprite_pip_desc = {
+        .shader = sg_make_shader(sprite_shader_desc(sg_query_backend())),
+        // An instance by sprite, its 4 vertexes are made from the vertex indexes
+        .layout =
+        {
+            .buffers = {{.step_func = SG_VERTEXSTEP_PER_INSTANCE}},
+            .attrs =
+            {
+                {.format = SG_VERTEXFORMAT_FLOAT2},
+                {.format = SG_VERTEXFORMAT_FLOAT2},
+                {.format = SG_VERTEXFORMAT_UBYTE4},
+                {.format = SG_VERTEXFORMAT_UBYTE4N},
+            }
+        },
+        .colors = {{.blend = pip_desc.colors[0].blend}},
+        .primitive_type = SG_PRIMITIVETYPE_TRIANGLE_STRIP,
+        .label = "sprite-pipeline",
+    };
+    state.spritePip = sg_make_pipeline(sprite_pip_desc);
+
+    // The ground tiles are updated by the game when they change, the atlas is shared with the sprites
+    state.groundBind.fs_images[SLOT_tiles] = sg_make_image((sg_image_desc){
+        .width  = Graphics::groundMapSize,
+        .height = Graphics::groundMapSize,
+        .usage = SG_USAGE_DYNAMIC,
+        .pixel_format = SG_PIXELFORMAT_RG8,
+        .label = "ground-tiles-image"});
+    state.groundBind.fs_images[SLOT_atlas] = state.bind.fs_images[SLOT_tex];
+
+    // No vertex buffer, the quad covering the screen is made from the vertex indexes
+    sg_pipeline_desc ground_pip_desc = {
+        .shader = sg_make_shader(ground_shader_desc(sg_query_backend())),
+        .colors = {{.blend = pip_desc.colors[0].blend}},
+        .primitive_type = SG_PRIMITIVETYPE_TRIANGLE_STRIP,
+        .label = "ground-pipeline",
+    };
+    state.groundPip = sg_make_pipeline(ground_pip_desc);
+
     // use sokol-imgui with all default-options (we're not doing
     // multi-sampled rendering or using non-default pixel formats)
     simgui_desc_t simgui_desc = { };
@@ -243,9 +332,9 @@ static void init()
 
     #ifdef HOT_RELOAD
     LoadDLL();
-    if(DLL_InitGame) DLL_InitGame(gameStateMemory, &tilemap, &frameData, &imguiData, &imTextureID);
+    if(DLL_InitGame) DLL_InitGame(gameStateMemory, &tilemap, &frameData, &imguiData, &imTextureID, residentChunkBudget, mapSize);
     #else
-    InitGame(gameStateMemory, &tilemap, &frameData, &imguiData, &imTextureID);
+    InitGame(gameStateMemory, &tilemap, &frameData, &imguiData, &imTextureID, residentChunkBudget, mapSize);
     #endif
 
     Audio::SetupSound();
@@ -258,14 +347,27 @@ static void init()
 	};
 }
 
+// In the background the frames are spaced out, most of them would be the same
+static void waitIdleFrame()
+{
+    if (!isWindowFocused && idleFramesPerSecond > 0)
+    {
+        std::this_thread::sleep_until(lastFrameStart + std::chrono::duration<double>(1.0 / idleFramesPerSecond));
+    }
+
+    lastFrameStart = std::chrono::steady_clock::now();
+}
+
 void frame()
 {
+    waitIdleFrame();
+
 	Graphics::IncreaseFrameCount();
 
     auto width  = sapp_width();
     auto height = sapp_height();
 
-    state.vs_window = {(float)width, (float)height, (float) Graphics::GetFrameCount()};
+    state.vs_window = {(float)width, (float)height};
 
     frameData.screenSize   = Vector2I{sapp_width(), sapp_height()};
     frameData.screenCenter = Vector2I{sapp_width(), sapp_height()} / 2;
@@ -290,33 +392,92 @@ void frame()
     #endif
 
     sg_begin_default_pass(&state.pass_action, sapp_width(), sapp_height());
-    sg_apply_pipeline(state.pip);
-    
+
+    if (frameData.ground.IsVisible)
+    {
+        if (frameData.ground.IsDirty)
+        {
+            // sokol can only replace the whole image, it's small enough to do it on the frames where a tile changed
+            sg_image_data groundTiles = {};
+            groundTiles.subimage[0][0] = {.ptr = frameData.ground.TilesPtr, .size = Graphics::groundMapSize * Graphics::groundMapSize * 2};
+            sg_update_image(state.groundBind.fs_images[SLOT_tiles], groundTiles);
+        }
+
+        sg_apply_pipeline(state.groundPip);
+        sg_apply_bindings(&state.groundBind);
+        sg_apply_uniforms(SG_SHADERSTAGE_VS, SLOT_ground_view, (sg_range){.ptr = frameData.ground.View, .size = sizeof(frameData.ground.View)});
+        sg_apply_uniforms(SG_SHADERSTAGE_FS, SLOT_ground_sheets, (sg_range){.ptr = frameData.ground.Sheets, .size = sizeof(frameData.ground.Sheets)});
+        sg_draw(0, 4, 1);
+    }
+
     // Check that the indices are in bounds
     // NOTE(seb): added this when debugging the graphic issue. Leaving it as it can't hurt!
     #ifndef NDEBUG
-    for (int index_idx = 0; index_idx < frameData.indexBufferUsed; index_idx++) {
+    for (int index_idx = 0; index_idx < frameData.indexBufferUsed && frameData.isGeometryDirty; index_idx++) {
         int idx = frameData.indexBufferPtr[index_idx];
         assert(idx < frameData.vertexBufferUsed && "An index was bigger than the index of the last vertex.");
         assert(idx >= 0 && "An index was smaller than zero.");
     }
     #endif
 
-    sg_update_buffer(state.bind.vertex_buffers[0], (sg_range){
-		.ptr = frameData.vertexBufferPtr,
-		.size = frameData.vertexBufferUsed * Graphics::VertexNbAttributes * sizeof(frameData.vertexBufferPtr[0])
-	});
+    // sokol refuses empty updates, the frames can have only sprites or only shapes.
+    // When the game didn't rebuild the geometry, the buffers already hold it from the previous frame
+    if (frameData.isGeometryDirty && frameData.indexBufferUsed > 0)
+    {
+        fitBuffer(state.bind.vertex_buffers[0], state.vertexCapacity, frameData.vertexBufferUsed * sizeof(frameData.vertexBufferPtr[0]), SG_BUFFERTYPE_VERTEXBUFFER, "triangle-vertices");
+        fitBuffer(state.bind.index_buffer, state.indexCapacity, frameData.indexBufferUsed * sizeof(frameData.indexBufferPtr[0]), SG_BUFFERTYPE_INDEXBUFFER, "triangle-indices");
+
+        sg_update_buffer(state.bind.vertex_buffers[0], (sg_range){
+            .ptr = frameData.vertexBufferPtr,
+            .size = frameData.vertexBufferUsed * sizeof(frameData.vertexBufferPtr[0])
+        });
+
+        sg_update_buffer(state.bind.index_buffer, (sg_range){
+            .ptr = frameData.indexBufferPtr,
+            .size = frameData.indexBufferUsed * sizeof(frameData.indexBufferPtr[0])
+        });
+    }
 
-    sg_update_buffer(state.bind.index_buffer, (sg_range){
-        .ptr = frameData.indexBufferPtr,
-        .size = frameData.indexBufferUsed * sizeof(frameData.indexBufferPtr[0])
-    });
+    if (frameData.isGeometryDirty && frameData.instanceBufferUsed > 0)
+    {
+        fitBuffer(state.spriteBind.vertex_buffers[0], state.instanceCapacity, frameData.instanceBufferUsed * sizeof(frameData.instanceBufferPtr[0]), SG_BUFFERTYPE_VERTEXBUFFER, "sprite-instances");
 
-    sg_apply_uniforms(SG_SHADERSTAGE_VS, SLOT_vs_window, (sg_range){.ptr = &state.vs_window, .size = sizeof(state.vs_window)});
-    sg_apply_bindings(&state.bind);
+        sg_update_buffer(state.spriteBind.vertex_buffers[0], (sg_range){
+            .ptr = frameData.instanceBufferPtr,
+            .size = frameData.instanceBufferUsed * sizeof(frameData.instanceBufferPtr[0])
+        });
+    }
 
-    //sg_draw(0, frameData.vertexBufferUsed * Graphics::VertexNbAttributes, 1);
-    sg_draw(0, frameData.indexBufferUsed, 1);
+    state.spriteView.screen_size[0] = (float)width;
+    state.spriteView.screen_size[1] = (float)height;
+    memcpy(state.spriteView.sheet_cells, frameData.sheetCells, sizeof(state.spriteView.sheet_cells));
+    memcpy(state.spriteView.sheet_origins, frameData.sheetOrigins, sizeof(state.spriteView.sheet_origins));
+
+    // A draw by batch, the draw calls keep the order of the shapes and the sprites and the pipeline changes with their type
+    for (int callIndex = 0; callIndex < frameData.drawCallUsed; callIndex++)
+    {
+        const DrawCall& call = frameData.drawCallPtr[callIndex];
+
+        if (call.Count == 0) continue;
+
+        if (call.Type == DrawCallType::Sprites)
+        {
+            memcpy(state.spriteView.transform, call.Transform, sizeof(state.spriteView.transform));
+            state.spriteBind.vertex_buffer_offsets[0] = call.First * sizeof(frameData.instanceBufferPtr[0]);
+
+            sg_apply_pipeline(state.spritePip);
+            sg_apply_bindings(&state.spriteBind);
+            sg_apply_uniforms(SG_SHADERSTAGE_VS, SLOT_sprite_view, (sg_range){.ptr = &state.spriteView, .size = sizeof(state.spriteView)});
+            sg_draw(0, 4, call.Count);
+        }
+        else
+        {
+            sg_apply_pipeline(state.pip);
+            sg_apply_uniforms(SG_SHADERSTAGE_VS, SLOT_vs_window, (sg_range){.ptr = &state.vs_window, .size = sizeof(state.vs_window)});
+            sg_apply_bindings(&state.bind);
+            sg_draw(call.First, call.Count, 1);
+        }
+    }
 
 	simgui_render();
     sg_end_pass();
@@ -330,10 +491,49 @@ void cleanup()
     sg_shutdown();
 }
 
+// Simulate the game time without window nor rendering, the save file is loaded before and saved after if there is one
+void RunHeadless(float gameTime, const char* saveFileName)
+{
+    gameStateMemory = malloc(GAME_STATE_MAX_BYTE_SIZE);
+    memset(gameStateMemory, 0, GAME_STATE_MAX_BYTE_SIZE);
+
+    #ifdef HOT_RELOAD
+    LoadDLL();
+    if (DLL_InitGame) DLL_InitGame(gameStateMemory, &tilemap, &frameData, &imguiData, &imTextureID, residentChunkBudget, mapSize);
+    if (DLL_FastForwardHeadless) DLL_FastForwardHeadless(gameStateMemory, gameTime, saveFileName);
+    #else
+    InitGame(gameStateMemory, &tilemap, &frameData, &imguiData, &imTextureID, residentChunkBudget, mapSize);
+    FastForwardHeadless(gameStateMemory, gameTime, saveFileName);
+    #endif
+}
+
 sapp_desc sokol_main(int argc, char *argv[])
 {
-    (void)argc;
-    (void)argv;
+    // --idle-fps <frames per second>, 0 to not limit the frames while the window isn't focused
+    // --resident-chunks <chunks>, 0 to keep all the chunks in memory
+    // --map-size <tiles>, with --fast-forward 0 it times the generation of a big map
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (strcmp(argv[i], "--idle-fps") == 0)
+        {
+            idleFramesPerSecond = atoi(argv[i + 1]);
+        }
+        else if (strcmp(argv[i], "--resident-chunks") == 0)
+        {
+            residentChunkBudget = atoi(argv[i + 1]);
+        }
+        else if (strcmp(argv[i], "--map-size") == 0)
+        {
+            mapSize = atoi(argv[i + 1]);
+        }
+    }
+
+    // --fast-forward <game seconds> [save file], the options go after
+    if (argc >= 3 && strcmp(argv[1], "--fast-forward") == 0)
+    {
+        RunHeadless((float)atof(argv[2]), argc >= 4 && strncmp(argv[3], "--", 2) != 0 ? argv[3] : nullptr);
+        exit(0);
+    }
 
     return (sapp_desc){
         .init_cb = init,
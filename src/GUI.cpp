@@ -1,6 +1,7 @@
 #include "GUI.h"
 #include "Graphics.h"
 #include "Tile.h"
+#include "TileDefinitions.h"
 #include "Grid.h"
 #include "Input.h"
 #include "Logger.h"
@@ -191,7 +192,7 @@ namespace GUI
         }
     }
 
-    void DrawPauseMenu(bool *gamePaused)
+    void DrawPauseMenu(bool *gamePaused, bool *fastForward)
     {
         SetupFullScreenWindow();
 
@@ -215,7 +216,7 @@ namespace GUI
             ImVec2 windowCenter(ImGui::GetCursorPos().x + windowContentRegion.x * 0.5f - buttonSize.x * 0.5f,
                                 ImGui::GetCursorPos().y + windowContentRegion.y * 0.5f - buttonSize.y * 0.5f);
 
-            float yOffset = ImGui::GetWindowSize().y / 14.f;
+            float yOffset = ImGui::GetWindowSize().y / 16.f;
 
             ImGui::SetCursorPos(ImVec2(windowCenter.x, 1.5f * yOffset));
             if (ImGui::Button("Resume", buttonSize)) 
@@ -224,12 +225,18 @@ namespace GUI
             }
 
             ImGui::SetCursorPos(ImVec2(windowCenter.x,  3 * yOffset));
+            if (ImGui::Button(*fastForward ? "Fast Forward : ON" : "Fast Forward : OFF", buttonSize))
+            {
+                *fastForward = !*fastForward;
+            }
+
+            ImGui::SetCursorPos(ImVec2(windowCenter.x,  4.5f * yOffset));
             if (ImGui::Button("Settings", buttonSize)) 
             {
                 optionMenuOpened = true;
             }
 
-            ImGui::SetCursorPos(ImVec2(windowCenter.x,  4.5f * yOffset));
+            ImGui::SetCursorPos(ImVec2(windowCenter.x,  6 * yOffset));
             if (ImGui::Button("Save", buttonSize)) 
             {
                 if(SaveGameptr != nullptr)
@@ -238,7 +245,7 @@ namespace GUI
                 }
             }
 
-            ImGui::SetCursorPos(ImVec2(windowCenter.x, 6 * yOffset));
+            ImGui::SetCursorPos(ImVec2(windowCenter.x, 7.5f * yOffset));
             if (ImGui::Button("Load", buttonSize))
             {
                 if (SaveGameptr != nullptr)
@@ -247,7 +254,7 @@ namespace GUI
                 }
             }
 
-            ImGui::SetCursorPos(ImVec2(windowCenter.x, 7.5 * yOffset));
+            ImGui::SetCursorPos(ImVec2(windowCenter.x, 9 * yOffset));
             if (ImGui::Button("Save : File2", buttonSize))
             {
                 if (SaveGameptr != nullptr)
@@ -256,7 +263,7 @@ namespace GUI
                 }
             }
 
-            ImGui::SetCursorPos(ImVec2(windowCenter.x, 9 * yOffset));
+            ImGui::SetCursorPos(ImVec2(windowCenter.x, 10.5f * yOffset));
             if (ImGui::Button("Load : File2", buttonSize))
             {
                 if (SaveGameptr != nullptr)
@@ -265,7 +272,7 @@ namespace GUI
                 }
             }
 
-            ImGui::SetCursorPos(ImVec2(windowCenter.x,  10.5f * yOffset));
+            ImGui::SetCursorPos(ImVec2(windowCenter.x,  12 * yOffset));
             if (ImGui::Button("Quit Game", buttonSize)) 
             {
                 exit(1);
@@ -277,7 +284,19 @@ namespace GUI
         }
     }
 
-    void DrawTileInventory(Tile& tile, bool* isMouseOnAWindow)
+    void DrawSimulationSpeed(float ticksPerSecond, int realTimeTicksPerSecond)
+    {
+        ImGui::SetNextWindowBgAlpha(0.5); // Transparent background
+        ImGui::Begin("Simulation Speed", NULL, fullScrennWinFlags);
+        ImGui::SetWindowPos(ImVec2(5, 5), ImGuiCond_Always);
+        ImGui::SetWindowFontScale(1.35f);
+
+        ImGui::Text("Fast forward : %d ticks/s (x%.1f)", (int)ticksPerSecond, ticksPerSecond / realTimeTicksPerSecond);
+
+        ImGui::End();
+    }
+
+    void DrawTileInventory(const Tile& tile, bool* isMouseOnAWindow)
     {
         ImVec2 windowPos(5, 120);
 
@@ -306,7 +325,7 @@ namespace GUI
         ImGui::Text("%s", title.c_str());
         ImGui::Separator();
         
-        for (auto pair: *tile.Inventory)
+        for (auto pair: tile.Inventory)
         {
             //TODO: Olive, the texture of the item
             auto texture = Texture((Icons) pair.first);
@@ -351,7 +370,7 @@ namespace GUI
 
         for (auto& building : buildings)
         {
-            auto uvs = Graphics::GetUvs(building);
+            const SpriteUvs& uvs = Graphics::GetUvs(building);
 
             ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.7f, 0.8f, 1.f, 1.00f));
 
@@ -376,7 +395,7 @@ namespace GUI
             ImGui::SetCursorPosX(windowCenter.x);
 
             // Use the sg_image handle (converted to ImTextureID) for the image button
-            if (ImGui::ImageButton(*imTilemapTextureID, buttonSize, ImVec2(uvs[0].X, uvs[0].Y), ImVec2(uvs[2].X, uvs[2].Y)))
+            if (ImGui::ImageButton(*imTilemapTextureID, buttonSize, ImVec2(uvs.Min.X, uvs.Min.Y), ImVec2(uvs.Max.X, uvs.Max.Y)))
             {
                 if (*buildingSelected != -1)
                 {
@@ -8,6 +8,8 @@
 #include "Logger.h"
 #include "UnitManager.h"
 #include "Grid.h"
+#include "MapGenerator.h"
+#include "TaskScheduler.h"
 #include "Logger.h"
 
 #include "Graphics.h"
@@ -19,6 +21,11 @@
 
 #include "Serialization.h"
 
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <new>
+
 // ========= Game Initialization functions ===========
 
 void GenerateMap();
@@ -26,14 +33,23 @@ void GenerateMap();
 // ========= Game Update functions ===========
 
 void UpdateCamera();
+void PrefetchView();
 void HandleInput();
+void KeepEditDetailed(TilePosition position);
 void DrawUi();
+bool IsGeometryDirty();
+
+// ========= Simulation functions ===========
+
+void UpdateSimulation(int ticks);
+void TickSimulation();
+void FastForwardFrame();
 
 // ========= Data exchange functions ===========
 
 void BindWithEngine(Image* tilemap, FrameData* frameData, ImGuiData* engineImGuiData, ImTextureID* imTextureID);
 void ReceiveDataFromEngine(FrameData* frameData, TimerData* timerData);
-void SendDataToEngine(FrameData* frameData);
+void SendDataToEngine(FrameData* frameData, bool isGeometryDirty);
 
 // ========= Game attributes ===========
 
@@ -49,8 +65,11 @@ struct GameState
 
 	bool GameStarted = false;
 	bool GamePaused  = false;
+	// Run the simulation as fast as possible instead of in real time
+	bool FastForward = false;
 
-	// int Seed;
+	// For what isn't tied to a tile, seeded from the map seed
+	RandomStream Random;
 };
 
 GameState *gameState = nullptr;
@@ -68,8 +87,27 @@ TileType textureToTileType[] =
 };
 
 int buildingSelected = 0;
+// Last tile of the drag, the line to the tile under the cursor is built so fast drags leave no hole
+bool isDragBuilding = false;
+TilePosition dragTilePosition;
+
+// Starting size of the world in tiles, it grows when building near its borders
+int gridWidth = 128, gridHeight = 128, tileSize = 100;
 
-int gridWidth = 5000, gridHeight = 5000, tileSize = 100;
+// File of the temporary directory the chunks are paged out to, when the engine gives a resident chunk budget
+const char* chunkFileName = "CityBuilderChunks.bin";
+// How many frames of camera motion are loaded in advance
+float cameraPrefetchFrames = 30.f;
+
+// Seconds the chunks stay simulated at full detail after the camera leaves them or the player edits them
+float viewDetailTime = 10.f;
+float editDetailTime = 60.f;
+int editDetailRadius = 16;
+
+// Real time spent ticking in each frame of the fast forward, the rest of the frame keeps the window responsive
+float fastForwardFrameBudget = 1.f / 40.f;
+float fastForwardTicksPerSecond = 0.f;
+Vector2F previousViewCenter;
 
 Vector2F screenSize;
 Vector2F centerOfScreen;
@@ -85,6 +123,14 @@ bool isMouseOnAWindow;
 
 ImTextureID* imTilemapTextureID;
 
+// The world transformation and the screen size the geometry was built with, it's drawn again while nothing it shows changed
+Matrix2x3F builtTransform;
+Vector2F builtScreenSize;
+bool isGeometryBuilt = false;
+
+// Tasks of the frame, kept between the frames so its nodes keep their memory
+TaskGraph frameGraph;
+
 // ========= GAME SERIALIZATION LOGIC ============
 void SerializeGame(Serializer* serializer)
 {
@@ -122,13 +168,43 @@ void LoadGame(const char* fileName)
 }
 
 // =========== Game Logic ============
-void InitGame(void* gameMemory, Image* tilemap, FrameData* frameData, ImGuiData* engineImGuiData, ImTextureID* imTextureID)
+void EnableChunkStreaming(int residentChunkBudget)
+{
+	std::error_code error;
+	std::filesystem::path directory = std::filesystem::temp_directory_path(error);
+
+	if (error)
+	{
+		LOG_ERROR("No temporary directory for the chunk file, " << error.message());
+	}
+	else if (gameState->Grid.EnableStreaming((directory / chunkFileName).string().c_str(), residentChunkBudget))
+	{
+		return;
+	}
+
+	LOG("The chunks stay in memory");
+}
+
+void InitGame(void* gameMemory, Image* tilemap, FrameData* frameData, ImGuiData* engineImGuiData, ImTextureID* imTextureID, int residentChunkBudget, int mapSize)
 {
 	BindWithEngine(tilemap, frameData, engineImGuiData, imTextureID);
 
 	gameState = (GameState *)gameMemory;
 
-	gameState->Grid = Grid(gridWidth, gridHeight, tileSize);
+	if (mapSize > 0)
+	{
+		gridWidth = mapSize;
+		gridHeight = mapSize;
+	}
+
+	// The game memory is raw, the grid is built in place
+	new (&gameState->Grid) Grid(gridWidth, gridHeight, tileSize);
+
+	if (residentChunkBudget > 0)
+	{
+		EnableChunkStreaming(residentChunkBudget);
+	}
+
 	gameState->UnitManager.SetGrid(&gameState->Grid);
 
 	GenerateMap();
@@ -142,16 +218,16 @@ void OnFrame(FrameData *frameData, TimerData *timerData, const simgui_frame_desc
 {
 	ReceiveDataFromEngine(frameData, timerData);
 
-	Graphics::ClearFrameBuffers();
-
 	simgui_new_frame(simguiFrameDesc);
 
 	Graphics::SetCameraSize(frameData->screenSize.X, frameData->screenSize.Y);
+	Graphics::SetCameraBounds(gameState->Grid.GetWorldMin(), gameState->Grid.GetWorldMax());
 	UpdateCamera();
 	// Update the current camera state.
 	Graphics::camera.Pivot = centerOfScreen;
 	gameState->Camera = Graphics::camera;
 	Graphics::CalculTransformationMatrix();
+	PrefetchView();
 
 	auto mousePosition = Input::GetMousePosition();
 	isMouseOnAWindow = currentImGuiData.IO->WantCaptureMouse;
@@ -165,13 +241,53 @@ void OnFrame(FrameData *frameData, TimerData *timerData, const simgui_frame_desc
 		GUI::DrawStartMenu(&gameState->GameStarted);
 	}
 	
-	gameState->Grid.Update();
-	gameState->UnitManager.UpdateUnits();
+	int ticks = gameState->FastForward ? 0 : Timer::ConsumeTicks();
+	bool isGeometryDirty = false;
+
+	// The simulation, then the geometry of the world if it changed.
+	// The grid and the units queue their sprites in the same draw list, the grid first
+	int simulate = frameGraph.Add([ticks]()
+	{
+		if (gameState->FastForward)
+		{
+			FastForwardFrame();
+		}
+		else
+		{
+			UpdateSimulation(ticks);
+		}
+	});
+
+	int drawGrid = frameGraph.Add([&isGeometryDirty]()
+	{
+		isGeometryDirty = IsGeometryDirty();
+
+		if (!isGeometryDirty) return;
+
+		Graphics::ClearFrameBuffers();
+		gameState->Grid.Draw(isMouseOnAWindow);
+	}, {simulate});
+
+	int drawUnits = frameGraph.Add([&isGeometryDirty]()
+	{
+		if (isGeometryDirty)
+		{
+			gameState->UnitManager.DrawUnits();
+		}
+	}, {drawGrid});
+
+	frameGraph.Add([&isGeometryDirty]()
+	{
+		if (!isGeometryDirty) return;
+
+		Graphics::FlushDrawList();
 
-	gameState->Grid.Draw(true, isMouseOnAWindow);
-	gameState->UnitManager.DrawUnits(true);
-	gameState->Grid.Draw(false, isMouseOnAWindow);
-	gameState->UnitManager.DrawUnits(false);
+		builtTransform = Graphics::transformMatrix;
+		builtScreenSize = Graphics::camera.ScreenSize;
+		isGeometryBuilt = true;
+	}, {drawUnits});
+
+	frameGraph.Run();
 
 	// Reset the transformation matrix in order to not apply the world transformation to the UI.
 	//Graphics::CalculTransformationMatrix(Vector2F::One);
@@ -181,7 +297,92 @@ void OnFrame(FrameData *frameData, TimerData *timerData, const simgui_frame_desc
 	// ImGui::SetNextWindowPos(ImVec2(460, 20), ImGuiCond_FirstUseEver);
 	// ImGui::ShowDemoWindow();
 
-	SendDataToEngine(frameData);
+	SendDataToEngine(frameData, isGeometryDirty);
+}
+
+void UpdateSimulation(int ticks)
+{
+	// The chunks are paged in and out once per frame
+	gameState->UnitManager.PrefetchChunks();
+	gameState->Grid.Update();
+
+	// The simulation runs at fixed ticks, the rendering interpolates between the last two
+	for (; ticks > 0; ticks--)
+	{
+		TickSimulation();
+	}
+
+	// The edits of a frame without tick
+	gameState->Grid.PublishChanges();
+}
+
+void TickSimulation()
+{
+	gameState->Grid.Tick();
+	gameState->UnitManager.UpdateUnits();
+	gameState->Grid.PublishChanges();
+}
+
+void FastForwardFrame()
+{
+	auto start = std::chrono::steady_clock::now();
+	float elapsedTime = 0.f;
+	int ticks = 0;
+
+	gameState->UnitManager.PrefetchChunks();
+	gameState->Grid.Update();
+
+	// Tick back to back for most of the frame, only the last tick is drawn
+	while (elapsedTime < fastForwardFrameBudget)
+	{
+		TickSimulation();
+		ticks++;
+
+		elapsedTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	fastForwardTicksPerSecond = ticks / elapsedTime;
+
+	// Nothing to interpolate, draw the units where they are
+	Timer::TickAccumulator = 0.f;
+	Timer::TickAlpha = 1.f;
+}
+
+void FastForwardHeadless(void* gameMemory, float gameTime, const char* saveFileName)
+{
+	gameState = (GameState *)gameMemory;
+
+	if (saveFileName != nullptr)
+	{
+		LoadGame(saveFileName);
+	}
+
+	// The headless runs are compared between machines, their ranges are split the same whatever the core count
+	TaskScheduler::SetDeterministic(true);
+
+	int ticks = (int)(gameTime * Timer::TicksPerSecond);
+	auto start = std::chrono::steady_clock::now();
+
+	TaskScheduler::ResetStats();
+
+	// Page the chunks in and out once per second of game time, like a frame would do
+	for (int tick = 0; tick < ticks; tick += Timer::TicksPerSecond)
+	{
+		UpdateSimulation(std::min(Timer::TicksPerSecond, ticks - tick));
+	}
+
+	float elapsedTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+
+	LOG("Simulated " << gameTime << " s in " << elapsedTime << " s, " << (int)(ticks / elapsedTime) << " ticks per second");
+
+	TaskSchedulerStats stats = TaskScheduler::GetStats();
+
+	LOG("Tasks : " << stats.TasksRun << " run, " << stats.Steals << " stolen, " << stats.IdleTime << " s idle on " << TaskScheduler::GetThreadCount() << " threads");
+
+	if (saveFileName != nullptr)
+	{
+		SaveGame(saveFileName);
+	}
 }
 
 void UpdateCamera()
@@ -233,6 +434,30 @@ void UpdateCamera()
 	}
 }
 
+void PrefetchView()
+{
+	Vector2F viewMin = Graphics::ScreenToWorld({0, 0});
+	Vector2F viewMax = Graphics::ScreenToWorld(screenSize);
+	Vector2F viewCenter = (viewMin + viewMax) / 2.f;
+
+	// Extend the view toward where the camera is going
+	Vector2F motion = (viewCenter - previousViewCenter) * cameraPrefetchFrames;
+	previousViewCenter = viewCenter;
+
+	Vector2F prefetchMin = {std::min(viewMin.X, viewMin.X + motion.X), std::min(viewMin.Y, viewMin.Y + motion.Y)};
+	Vector2F prefetchMax = {std::max(viewMax.X, viewMax.X + motion.X), std::max(viewMax.Y, viewMax.Y + motion.Y)};
+
+	gameState->Grid.PrefetchArea(gameState->Grid.GetTilePosition(prefetchMin), gameState->Grid.GetTilePosition(prefetchMax));
+
+	// Where the camera is going is simulated at full detail before it's seen
+	gameState->Grid.KeepDetailed(gameState->Grid.GetTilePosition(prefetchMin), gameState->Grid.GetTilePosition(prefetchMax), viewDetailTime);
+}
+
+void KeepEditDetailed(TilePosition position)
+{
+	gameState->Grid.KeepDetailed(position + TilePosition{-editDetailRadius, -editDetailRadius}, position + TilePosition{editDetailRadius, editDetailRadius}, editDetailTime);
+}
+
 void HandleInput()
 {
 	if (Input::IsKeyPressed(SAPP_KEYCODE_ESCAPE) && gameState->GameStarted)
@@ -245,7 +470,7 @@ void HandleInput()
 	if (Input::IsKeyPressed(SAPP_KEYCODE_F))
 	{
 		// Spawn a unit
-		gameState->UnitManager.AddUnit(Unit(gameState->Grid.ToWorldPosition(gameState->Grid.GetTiles(TileType::MayorHouse)[0]) + Vector2F{Random::Range(0, 25), Random::Range(0, 25)}));
+		gameState->UnitManager.AddUnit(Unit(gameState->Grid.ToWorldPosition(gameState->Grid.GetTiles(TileType::MayorHouse)[0]) + Vector2F{gameState->Random.Range(0, 25), gameState->Random.Range(0, 25)}));
 	}
 
 	if (!isMouseOnAWindow)
@@ -255,16 +480,22 @@ void HandleInput()
 			auto mousePosition = Input::GetMousePosition();
 			auto mouseWorldPosition = Graphics::ScreenToWorld(mousePosition);
 			auto tilePosition = gameState->Grid.GetTilePosition(mouseWorldPosition);
+			auto from = isDragBuilding ? dragTilePosition : tilePosition;
 
-			if (gameState->Grid.IsTileValid(tilePosition) && gameState->Grid.CanBuild(tilePosition, textureToTileType[buildingSelected]))
+			if (gameState->Grid.PaintLine(from, tilePosition, textureToTileType[buildingSelected], Input::IsKeyHeld(SAPP_KEYCODE_LEFT_SHIFT), true) > 0)
 			{
-				gameState->Grid.SetTile(tilePosition, Tile(textureToTileType[buildingSelected]));
+				KeepEditDetailed(tilePosition);
 
-				if (Input::IsKeyHeld(SAPP_KEYCODE_LEFT_SHIFT))
-				{
-					gameState->Grid.GetTile(tilePosition).IsBuilt = true;
-				}
+				// Make room for the city to expand
+				gameState->Grid.GrowAround(tilePosition);
 			}
+
+			isDragBuilding = true;
+			dragTilePosition = tilePosition;
+		}
+		else
+		{
+			isDragBuilding = false;
 		}
 
 		if (Input::IsMouseButtonPressed(SAPP_MOUSEBUTTON_RIGHT))
@@ -273,29 +504,27 @@ void HandleInput()
 			auto mousePosition = Input::GetMousePosition();
 			auto mouseWorldPosition = Graphics::ScreenToWorld(mousePosition);
 			auto tilePosition = gameState->Grid.GetTilePosition(mouseWorldPosition);
+
+			if (gameState->Grid.PeekTile(tilePosition).Type == TileType::None) return;
+
 			auto &tile = gameState->Grid.GetTile(tilePosition);
 
-		if (tile.Type == TileType::None) return;
+			KeepEditDetailed(tilePosition);
 
 			if (tile.NeedToBeDestroyed)
 			{
 				// Cancel the destruction
-				tile.NeedToBeDestroyed = false;
-				tile.Progress = 0;
+				gameState->Grid.SetNeedToBeDestroyed(tilePosition, false);
 			}
 			// Can be destroyed immediately
 			else if (tile.Type == TileType::Road || !tile.IsBuilt)
 			{
-				tile.Type = tile.Type == TileType::Quarry ? TileType::Stone : TileType::None;
-				tile.IsBuilt = true;
-				tile.NeedToBeDestroyed = false;
-				tile.Progress = 0;
+				gameState->Grid.SetTileType(tilePosition, tile.Type == TileType::Quarry ? TileType::Stone : TileType::None);
 			}
 			// Can be destroyed by a builder
 			else if (gameState->Grid.CanBeDestroyed(tilePosition))
 			{
-				tile.Progress = 0;
-				tile.NeedToBeDestroyed = true;
+				gameState->Grid.SetNeedToBeDestroyed(tilePosition, true);
 			}
 		}
 
@@ -305,15 +534,12 @@ void HandleInput()
 			auto mousePosition = Input::GetMousePosition();
 			auto mouseWorldPosition = Graphics::ScreenToWorld(mousePosition);
 			auto tilePosition = gameState->Grid.GetTilePosition(mouseWorldPosition);
-			auto &tile = gameState->Grid.GetTile(tilePosition);
 
-			if (tile.Type != TileType::Road)
+			if (gameState->Grid.PeekTile(tilePosition).Type != TileType::Road)
 				return;
 
-			tile.Type = TileType::None;
-			tile.IsBuilt = true;
-			tile.NeedToBeDestroyed = false;
-			tile.Progress = 0;
+			gameState->Grid.SetTileType(tilePosition, TileType::None);
+			KeepEditDetailed(tilePosition);
 		}
 	}
 }
@@ -322,7 +548,12 @@ void DrawUi()
 {
 	if (gameState->GamePaused)
 	{
-		GUI::DrawPauseMenu(&gameState->GamePaused);
+		GUI::DrawPauseMenu(&gameState->GamePaused, &gameState->FastForward);
+	}
+
+	if (gameState->FastForward)
+	{
+		GUI::DrawSimulationSpeed(fastForwardTicksPerSecond, Timer::TicksPerSecond);
 	}
 
 	GUI::DrawConstructionMenu(&buildingSelected, &screenSize, imTilemapTextureID);
@@ -331,7 +562,7 @@ void DrawUi()
 
 	if (gameState->Grid.IsTileValid(mouseTilePosition))
 	{
-		Tile &tile = gameState->Grid.GetTile(mouseTilePosition);
+		const Tile &tile = gameState->Grid.PeekTile(mouseTilePosition);
 
         if (tile.Type != TileType::None && tile.Type != TileType::Road)
         {
@@ -342,56 +573,34 @@ void DrawUi()
 
 void GenerateMap()
 {
-	auto mayorHouse = Tile(TileType::MayorHouse);
-	mayorHouse.IsBuilt = true;
-	gameState->Grid.SetTile(gameState->Grid.GetTilePosition(centerOfScreen), mayorHouse);
+	Prefab town = {3, 3, {
+		TileType::MayorHouse,      TileType::None, TileType::BuilderHut,
+		TileType::None,            TileType::None, TileType::None,
+		TileType::LogisticsCenter, TileType::None, TileType::House,
+	}};
 
-	auto builderHouse = Tile(TileType::BuilderHut);
-	builderHouse.IsBuilt = true;
-	gameState->Grid.SetTile(gameState->Grid.GetTilePosition(centerOfScreen) + TilePosition{2, 0}, builderHouse);
+	gameState->Grid.StampPrefab(town, gameState->Grid.GetTilePosition(centerOfScreen), true, false);
 
-	auto logisticsCenter = Tile(TileType::LogisticsCenter);
-	logisticsCenter.IsBuilt = true;
-	gameState->Grid.SetTile(gameState->Grid.GetTilePosition(centerOfScreen) + TilePosition{0, 2}, logisticsCenter);
+	// Generate a random seed for the map
+	RandomStream entropy = RandomStream::FromEntropy();
+	gameState->Grid.SetSeed(((uint64_t)entropy.Next() << 32) | entropy.Next());
+	gameState->Random = RandomStream(gameState->Grid.GetSeed()).Split(0);
 
-	auto house = Tile(TileType::House);
-	house.IsBuilt = true;
-	gameState->Grid.SetTile(gameState->Grid.GetTilePosition(centerOfScreen) + TilePosition{2, 2}, house);
+	// Forests and rock fields around the town, the whole map is generated on all the cores
+	MapGenerator generator = MapGenerator(gameState->Grid.GetSeed());
+	generator.ClearingCenter = gameState->Grid.GetTilePosition(centerOfScreen);
 
-	// Generate a random seed for the map
-	Random::SetSeed(Random::Range(0, 1000000));
-	Random::UseSeed();
+	auto start = std::chrono::steady_clock::now();
 
-	// Place random trees
-	gameState->Grid.ForEachTile([&](Tile &tile, TilePosition position)
-								{
-		if (tile.Type == TileType::None)
-		{
-			if (Random::Range(0, 100) < 10)
-			{
-				tile.Type = TileType::Tree;
-				tile.TreeGrowth = Random::Range(0.f, 30.f);
-				tile.IsBuilt = true;
-			}
-		} });
+	gameState->Grid.Generate(generator);
 
-	// Place random rocks
-	gameState->Grid.ForEachTile([&](Tile &tile, TilePosition position)
-								{
-		if (tile.Type == TileType::None)
-		{
-			if (Random::Range(0, 100) < 1)
-			{
-				tile.Type = TileType::Stone;
-				tile.IsBuilt = true;
-			}
-		} });
+	float elapsedTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
 
-	Random::StopUseSeed();
+	LOG("Generated the map of " << gameState->Grid.GetWidth() << "x" << gameState->Grid.GetHeight() << " tiles in " << elapsedTime * 1000.f << " ms");
 
 	for (int i = 0; i < 3; i++)
 	{
-		gameState->UnitManager.AddUnit(Unit(gameState->Grid.ToWorldPosition(gameState->Grid.GetTiles(TileType::MayorHouse)[0]) + Vector2F{Random::Range(0, 25), Random::Range(0, 25)}));
+		gameState->UnitManager.AddUnit(Unit(gameState->Grid.ToWorldPosition(gameState->Grid.GetTiles(TileType::MayorHouse)[0]) + Vector2F{gameState->Random.Range(0, 25), gameState->Random.Range(0, 25)}));
 	}
 }
 
@@ -407,6 +616,7 @@ void BindWithEngine(Image* tilemap, FrameData* frameData, ImGuiData* engineImGui
 
 	Graphics::textureWidth  = tilemap->GetWidth();
 	Graphics::textureHeight = tilemap->GetHeight();
+	Graphics::BakeUvs();
 
 	imTilemapTextureID = imTextureID;
 }
@@ -425,13 +635,36 @@ void ReceiveDataFromEngine(FrameData* frameData, TimerData* timerData)
 	Timer::SmoothDeltaTime = timerData->SmoothDeltaTime;
 }
 
-void SendDataToEngine(FrameData* frameData)
+bool IsGeometryDirty()
+{
+	if (!isGeometryBuilt || builtScreenSize != Graphics::camera.ScreenSize) return true;
+
+	if (memcmp(builtTransform.values, Graphics::transformMatrix.values, sizeof(builtTransform.values)) != 0) return true;
+
+	return gameState->Grid.IsRenderDirty(isMouseOnAWindow) || gameState->UnitManager.IsRenderDirty();
+}
+
+void SendDataToEngine(FrameData* frameData, bool isGeometryDirty)
 {
 	// Send the frame data to the engine.
-	frameData->vertexBufferPtr  = Graphics::vertexes;
+	frameData->vertexBufferPtr  = Graphics::vertexes.data();
 	frameData->vertexBufferUsed = Graphics::vertexesUsed;
-	frameData->indexBufferPtr   = Graphics::indices;
+	frameData->indexBufferPtr   = Graphics::indices.data();
 	frameData->indexBufferUsed  = Graphics::indicesUsed;
+	frameData->instanceBufferPtr  = Graphics::sprites.data();
+	frameData->instanceBufferUsed = Graphics::spritesUsed;
+	frameData->drawCallPtr        = Graphics::drawCalls.data();
+	frameData->drawCallUsed       = Graphics::drawCallsUsed;
+	frameData->isGeometryDirty    = isGeometryDirty;
+
+	for (int sheet = 0; sheet < (int)TileSheet::Count; sheet++)
+	{
+		Graphics::GetSheetGeometry((TileSheet)sheet, frameData->sheetCells[sheet], frameData->sheetOrigins[sheet]);
+	}
+
+	// The engine uploads the ground tiles only when they changed
+	frameData->ground = Graphics::ground;
+	Graphics::ground.IsDirty = false;
 }
 
 #ifdef __cplusplus // If used by C++ code,
@@ -454,9 +687,14 @@ extern "C"		   // we need to export the C interface
 		BindWithEngine(tilemap, frameData, engineImGuiData, imTextureID);
 	}
 
-	EXPORT void DLL_InitGame(void* gameMemory, Image* tilemap, FrameData* frameData, ImGuiData* engineImGuiData, ImTextureID* imTextureID)
+	EXPORT void DLL_InitGame(void* gameMemory, Image* tilemap, FrameData* frameData, ImGuiData* engineImGuiData, ImTextureID* imTextureID, int residentChunkBudget, int mapSize)
+	{
+		InitGame(gameMemory, tilemap, frameData, engineImGuiData, imTextureID, residentChunkBudget, mapSize);
+	}
+
+	EXPORT void DLL_FastForwardHeadless(void* gameMemory, float gameTime, const char* saveFileName)
 	{
-		InitGame(gameMemory, tilemap, frameData, engineImGuiData, imTextureID);
+		FastForwardHeadless(gameMemory, gameTime, saveFileName);
 	}
 
 	EXPORT void DLL_OnFrame(void *gameMemory, FrameData *frameData, TimerData *timerData, const simgui_frame_desc_t* simguiFrameDesc)
@@ -1,14 +1,199 @@
 #include "Graphics.h"
 #include "Input.h"
 #include "Logger.h"
+#include "TaskScheduler.h"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 
 constexpr float textureBleed = 0.005f;
+// Sprites of the sorted draw list copied by a task
+constexpr int drawListCopyGrain = 8192;
 
 namespace Graphics
 {
+    // Make room for count more elements after the used ones, the buffer doubles when it's full
+    template<typename T>
+    static T* reserve(std::vector<T>& buffer, int used, int count)
+    {
+        if (used + count > (int)buffer.size())
+        {
+            buffer.resize(std::max({(size_t)startBufferCapacity, buffer.size() * 2, (size_t)(used + count)}));
+        }
+
+        return buffer.data() + used;
+    }
+
+    static uint32_t* allocateIndices(int count)
+    {
+        uint32_t* allocated = reserve(indices, indicesUsed, count);
+        indicesUsed += count;
+
+        return allocated;
+    }
+
+    // The draw call the next shapes or sprites go in, a new one starts when the type or the transformation changes
+    static DrawCall& getDrawCall(DrawCallType type)
+    {
+        if (drawCallsUsed > 0)
+        {
+            DrawCall& last = drawCalls[drawCallsUsed - 1];
+            bool isSameTransform = true;
+
+            for (int row = 0; row < 2 && type == DrawCallType::Sprites; row++)
+            {
+                for (int column = 0; column < 3; column++)
+                {
+                    isSameTransform &= last.Transform[row][column] == transformMatrix.values[row][column];
+                }
+            }
+
+            if (last.Type == type && isSameTransform) return last;
+        }
+
+        DrawCall& call = *reserve(drawCalls, drawCallsUsed, 1);
+        drawCallsUsed++;
+        call.Type = type;
+        call.First = type == DrawCallType::Sprites ? spritesUsed : indicesUsed;
+        call.Count = 0;
+
+        for (int row = 0; row < 2; row++)
+        {
+            call.Transform[row][0] = transformMatrix.values[row][0];
+            call.Transform[row][1] = transformMatrix.values[row][1];
+            call.Transform[row][2] = transformMatrix.values[row][2];
+            call.Transform[row][3] = 0;
+        }
+
+        return call;
+    }
+
+    static uint8_t toByte(float channel)
+    {
+        return (uint8_t)(std::clamp(channel, 0.f, 1.f) * 255.f + 0.5f);
+    }
+
+    static void setSprite(SpriteInstance& sprite, Vector2F position, Vector2F size, Color color, Texture texture)
+    {
+        sprite.Position = position;
+        sprite.Size = size;
+        sprite.Sprite[0] = texture.TileSheetIndex == TileSheet::None ? SpriteInstance::FlatSheet : (uint8_t)texture.TileSheetIndex;
+        sprite.Sprite[1] = texture.TileSheetIndex == TileSheet::None ? 0 : (uint8_t)texture.TileIndex;
+        sprite.Sprite[2] = 0;
+        sprite.Sprite[3] = 0;
+        sprite.Color[0] = toByte(color.R);
+        sprite.Color[1] = toByte(color.G);
+        sprite.Color[2] = toByte(color.B);
+        sprite.Color[3] = toByte(color.A);
+    }
+
+    static void appendSprite(Vector2F position, Vector2F size, Color color, Texture texture)
+    {
+        DrawCall& call = getDrawCall(DrawCallType::Sprites);
+
+        setSprite(*reserve(sprites, spritesUsed, 1), position, size, color, texture);
+        spritesUsed++;
+
+        call.Count++;
+    }
+
+    // Unsigned bits in the same order as the floats, negative ones included
+    static uint32_t toSortableBits(float value)
+    {
+        uint32_t bits = std::bit_cast<uint32_t>(value);
+
+        return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+    }
+
+    static void setQueuedSprite(int index, DrawLayer layer, Vector2F position, Vector2F size, Texture texture, Color color)
+    {
+        SpriteInstance& sprite = drawListSprites[index];
+        setSprite(sprite, position, size, color, texture);
+
+        // Only the objects are sorted by their bottom, in the other layers the sprites of a sheet follow each other
+        uint32_t ySort = layer == DrawLayer::Objects ? toSortableBits(position.Y + size.Y) : 0;
+
+        drawKeys[index].Key = (uint64_t)layer << 56 | (uint64_t)ySort << 24 | (uint64_t)sprite.Sprite[0] << 16;
+        drawKeys[index].Sprite = index;
+    }
+
+    // Make room for count sprites at the end of the draw list, returns the first one
+    static int reserveDrawList(int count)
+    {
+        reserve(drawListSprites, drawListUsed, count);
+        reserve(drawKeys, drawListUsed, count);
+
+        int first = drawListUsed;
+        drawListUsed += count;
+
+        return first;
+    }
+
+    // The keys of the draw list go back and forth between drawKeys and this buffer during the sort
+    static std::vector<DrawKey> sortedKeys;
+
+    // Radix sort of the draw list a byte at a time from the lowest one, the sprites with the same key stay in the order they were queued
+    static void sortDrawList()
+    {
+        int histograms[8][256] = {};
+
+        for (int i = 0; i < drawListUsed; i++)
+        {
+            uint64_t key = drawKeys[i].Key;
+
+            for (int digit = 0; digit < 8; digit++)
+            {
+                histograms[digit][(key >> (digit * 8)) & 0xFF]++;
+            }
+        }
+
+        sortedKeys.resize(drawKeys.size());
+
+        DrawKey* from = drawKeys.data();
+        DrawKey* to = sortedKeys.data();
+
+        for (int digit = 0; digit < 8; digit++)
+        {
+            int shift = digit * 8;
+            int* histogram = histograms[digit];
+
+            // The keys all have the same byte, like the unused low bytes, the pass wouldn't move them
+            if (histogram[(from[0].Key >> shift) & 0xFF] == drawListUsed) continue;
+
+            int offset = 0;
+
+            for (int value = 0; value < 256; value++)
+            {
+                int count = histogram[value];
+                histogram[value] = offset;
+                offset += count;
+            }
+
+            for (int i = 0; i < drawListUsed; i++)
+            {
+                to[histogram[(from[i].Key >> shift) & 0xFF]++] = from[i];
+            }
+
+            std::swap(from, to);
+        }
+
+        if (from != drawKeys.data())
+        {
+            drawKeys.swap(sortedKeys);
+        }
+    }
+
+    // Add the indexes added since the start of the shape to the current draw call
+    static void endShape()
+    {
+        DrawCall& call = getDrawCall(DrawCallType::Shapes);
+
+        call.Count = indicesUsed - call.First;
+    }
+
     int GetFrameCount()
     {
         return Graphics::frameCount;
@@ -19,29 +204,60 @@ namespace Graphics
 		Graphics::frameCount++;
 	}
 
-    std::vector<Vector2F> GetUvs(Texture texture)
+    void BakeUvs()
     {
-        int tileSheetIndex = static_cast<int>(texture.TileSheetIndex);
-        int textureSize = tileSheets[tileSheetIndex].GetHeight();
         int tileMapY = 0;
-		float widthPercent = textureSize / (float) textureWidth;
-		float heightPercent = textureSize / (float) textureHeight;
 
-        for (int i = 0; i < tileSheetIndex; i++)
+        uvTable.clear();
+
+        for (int sheet = 0; sheet < (int)TileSheet::Count; sheet++)
         {
-            tileMapY += tileSheets[i].GetHeight() + 1;
+            // The sprites of a sheet are squares as high as the sheet, in a row
+            int textureSize = tileSheets[sheet].GetHeight();
+            int spriteCount = textureSize > 0 ? tileSheets[sheet].GetWidth() / textureSize : 0;
+            float widthPercent = textureSize / (float) textureWidth;
+            float heightPercent = textureSize / (float) textureHeight;
+            float width = widthPercent * (1.f - textureBleed);
+            float height = heightPercent * (1.f - textureBleed);
+            float Y = tileMapY / (float)textureHeight + heightPercent * textureBleed;
+
+            sheetFirstSprite[sheet] = (int)uvTable.size();
+
+            for (int tileIndex = 0; tileIndex < spriteCount; tileIndex++)
+            {
+                float X = tileIndex * textureSize / (float)textureWidth + widthPercent * textureBleed;
+
+                uvTable.push_back({{X, Y}, {X + width, Y + height}});
+            }
+
+            sheetCells[sheet][0] = widthPercent;
+            sheetCells[sheet][1] = 0;
+            sheetCells[sheet][2] = width;
+            sheetCells[sheet][3] = height;
+            sheetOrigins[sheet][0] = widthPercent * textureBleed;
+            sheetOrigins[sheet][1] = Y;
+            sheetOrigins[sheet][2] = 0;
+            sheetOrigins[sheet][3] = 0;
+
+            tileMapY += textureSize + 1;
         }
 
-        float width = widthPercent * (1.f - textureBleed);
-        float height = heightPercent * (1.f - textureBleed);
-        float X = texture.TileIndex * textureSize / (float)textureWidth + widthPercent * textureBleed;
-        float Y = tileMapY / (float)textureHeight + heightPercent * textureBleed;
+        sheetFirstSprite[(int)TileSheet::Count] = (int)uvTable.size();
+    }
+
+    const SpriteUvs& GetUvs(Texture texture)
+    {
+        int sprite = sheetFirstSprite[(int)texture.TileSheetIndex] + texture.TileIndex;
+
+        assert(sprite < sheetFirstSprite[(int)texture.TileSheetIndex + 1] && "The sprite isn't in the atlas");
 
-        return {
-            {X, Y},
-            {X + width, Y},
-            {X + width, Y + height},
-            {X, Y + height}};
+        return uvTable[sprite];
+    }
+
+    void GetSheetGeometry(TileSheet sheet, float cell[4], float origin[4])
+    {
+        memcpy(cell, sheetCells[(int)sheet], sizeof(sheetCells[0]));
+        memcpy(origin, sheetOrigins[(int)sheet], sizeof(sheetOrigins[0]));
     }
 
     Vector2F GetTransformedPosition(Vector2F position, Vector2F pivot, Vector2F scale, float rotationDegree, Vector2F size)
@@ -60,51 +276,85 @@ namespace Graphics
 
     void AppendVertex(Vertex vertex)
     {
-        vertex.Position = Matrix2x3F::Multiply(transformMatrix, vertex.Position);
-        int vertexIndex = vertexesUsed * VertexNbAttributes;
-
-        assert(vertexIndex + VertexNbAttributes < maxVertexes && "Exceeded max vertexes");
-
-        vertexes[vertexIndex + 0] = vertex.Position.X;
-        vertexes[vertexIndex + 1] = vertex.Position.Y;
-        vertexes[vertexIndex + 2] = 0;
-        vertexes[vertexIndex + 3] = vertex.Color.R;
-        vertexes[vertexIndex + 4] = vertex.Color.G;
-        vertexes[vertexIndex + 5] = vertex.Color.B;
-        vertexes[vertexIndex + 6] = vertex.Color.A;
-        vertexes[vertexIndex + 7] = vertex.U;
-        vertexes[vertexIndex + 8] = vertex.V;
-		vertexes[vertexIndex + 9] = (float) frameCount;
-
+        PackedVertex& packed = *reserve(vertexes, vertexesUsed, 1);
         vertexesUsed++;
+        bool isTextured = vertex.U != -1 || vertex.V != -1;
+
+        packed.Position = Matrix2x3F::Multiply(transformMatrix, vertex.Position);
+        packed.Color[0] = toByte(vertex.Color.R);
+        packed.Color[1] = toByte(vertex.Color.G);
+        packed.Color[2] = toByte(vertex.Color.B);
+        packed.Color[3] = toByte(vertex.Color.A);
+        packed.U = isTextured ? (uint16_t)((uint16_t)(std::clamp(vertex.U, 0.f, 1.f) * 32767.f + 0.5f) << 1 | 1) : 0;
+        packed.V = isTextured ? (uint16_t)(std::clamp(vertex.V, 0.f, 1.f) * 65535.f + 0.5f) : 0;
     }
 
-    void DrawRect(Vector2F position, Vector2F size, Color color, std::vector<Vector2F> uvs)
+    void DrawRect(Vector2F position, Vector2F size, Color color, const SpriteUvs* uvs, bool isCulled)
     {
-		if (!IsVisible(position, size)) return;
+		if (!isCulled && !IsVisible(position, size)) return;
 
-        if (uvs.empty())
+        // The flat rectangles are sprites without texture, only the custom uvs need the vertexes
+        if (uvs == nullptr)
         {
-            uvs = {{-1, -1}, {-1, -1}, {-1, -1}, {-1, -1}};
+            appendSprite(position, size, color, Texture());
+            return;
         }
 
+        getDrawCall(DrawCallType::Shapes);
+
         int startIndex = vertexesUsed;
 
-        AppendVertex({position, color, uvs[0].X, uvs[0].Y});
-        AppendVertex({position + Vector2F{size.X, 0}, color, uvs[1].X, uvs[1].Y});
-        AppendVertex({position + size, color, uvs[2].X, uvs[2].Y});
-        AppendVertex({position + Vector2F{0, size.Y}, color, uvs[3].X, uvs[3].Y});
+        AppendVertex({position, color, uvs->Min.X, uvs->Min.Y});
+        AppendVertex({position + Vector2F{size.X, 0}, color, uvs->Max.X, uvs->Min.Y});
+        AppendVertex({position + size, color, uvs->Max.X, uvs->Max.Y});
+        AppendVertex({position + Vector2F{0, size.Y}, color, uvs->Min.X, uvs->Max.Y});
+
+        uint32_t* quad = allocateIndices(6);
+        quad[0] = startIndex;
+        quad[1] = startIndex + 1;
+        quad[2] = startIndex + 2;
+        quad[3] = startIndex;
+        quad[4] = startIndex + 2;
+        quad[5] = startIndex + 3;
+
+        endShape();
+    }
+
+    void SetGroundTile(int x, int y, Texture texture)
+    {
+        assert((texture.TileSheetIndex == TileSheet::Land || texture.TileSheetIndex == TileSheet::Road) && "Only land and roads are in the ground");
+
+        uint8_t* texel = groundTiles + ((x & (groundMapSize - 1)) + (y & (groundMapSize - 1)) * groundMapSize) * 2;
 
-        indices[indicesUsed++] = startIndex;
-        indices[indicesUsed++] = startIndex + 1;
-        indices[indicesUsed++] = startIndex + 2;
-        indices[indicesUsed++] = startIndex;
-        indices[indicesUsed++] = startIndex + 2;
-        indices[indicesUsed++] = startIndex + 3;
+        texel[0] = (uint8_t)texture.TileSheetIndex;
+        texel[1] = (uint8_t)texture.TileIndex;
+        ground.IsDirty = true;
+    }
+
+    void DrawGround(Vector2F worldMin, Vector2F worldMax, float tileSize)
+    {
+        Vector2F topLeft = ScreenToWorld({0, 0}) / tileSize;
+        Vector2F bottomRight = ScreenToWorld(camera.ScreenSize) / tileSize;
+
+        ground.IsVisible = true;
+        ground.View[0] = topLeft.X;
+        ground.View[1] = topLeft.Y;
+        ground.View[2] = bottomRight.X;
+        ground.View[3] = bottomRight.Y;
+
+        ground.Sheets[0][0] = worldMin.X / tileSize;
+        ground.Sheets[0][1] = worldMin.Y / tileSize;
+        ground.Sheets[0][2] = worldMax.X / tileSize;
+        ground.Sheets[0][3] = worldMax.Y / tileSize;
+
+        GetSheetGeometry(TileSheet::Land, ground.Sheets[1], ground.Sheets[2]);
+        GetSheetGeometry(TileSheet::Road, ground.Sheets[3], ground.Sheets[4]);
     }
 
     void DrawCircle(Vector2F position, float radius, Color color, int segments)
     {
+        getDrawCall(DrawCallType::Shapes);
+
         int startIndex = vertexesUsed;
 
         AppendVertex({{position.X, position.Y}, color});
@@ -116,12 +366,16 @@ namespace Graphics
             AppendVertex({{position.X + cosf(angle) * radius, position.Y + sinf(angle) * radius}, color});
         }
 
+        uint32_t* triangles = allocateIndices((segments + 1) * 3);
+
         for (int i = 0; i <= segments; i++)
         {
-            indices[indicesUsed++] = startIndex + 1;
-            indices[indicesUsed++] = startIndex + i + 1;
-            indices[indicesUsed++] = startIndex + i + 2;
+            triangles[i * 3 + 0] = startIndex + 1;
+            triangles[i * 3 + 1] = startIndex + i + 1;
+            triangles[i * 3 + 2] = startIndex + i + 2;
         }
+
+        endShape();
     }
 
     void DrawLine(Vector2F start, Vector2F end, float thickness, Color color)
@@ -135,11 +389,15 @@ namespace Graphics
         Vector2F end1 = end + normal * thickness / 2;
         Vector2F end2 = end - normal * thickness / 2;
 
-        DrawCustomShape({start1, end1, end2, start2}, color);
+        Vector2F points[4] = {start1, end1, end2, start2};
+
+        DrawCustomShape(points, color);
     }
 
-    void DrawCustomShape(std::vector<Vector2F> points, Color color)
+    void DrawCustomShape(std::span<const Vector2F> points, Color color)
     {
+        getDrawCall(DrawCallType::Shapes);
+
         int startIndex = vertexesUsed;
 
         for (auto &point : points)
@@ -147,34 +405,88 @@ namespace Graphics
             AppendVertex({{point.X, point.Y}, color});
         }
 
-        for (int i = 0; i < (int) points.size() - 2; i++)
+        int triangleCount = std::max((int) points.size() - 2, 0);
+        uint32_t* triangles = allocateIndices(triangleCount * 3);
+
+        for (int i = 0; i < triangleCount; i++)
         {
-            indices[indicesUsed++] = startIndex;
-            indices[indicesUsed++] = startIndex + i + 1;
-            indices[indicesUsed++] = startIndex + i + 2;
+            triangles[i * 3 + 0] = startIndex;
+            triangles[i * 3 + 1] = startIndex + i + 1;
+            triangles[i * 3 + 2] = startIndex + i + 2;
         }
+
+        endShape();
     }
 
     void DrawObject(DrawableObject object)
     {
-        std::vector<Vector2F> uvs = {};
+        Vector2F position = GetTransformedPosition(object.Position, object.Pivot, object.Scale, object.Rotation, object.Size);
+        Vector2F size = object.Size * object.Scale;
+
+        DrawSprite(position, size, object.Texture, object.Color, object.IsCulled);
+    }
+
+    void DrawSprite(Vector2F position, Vector2F size, Texture texture, Color color, bool isCulled)
+    {
+        if (!isCulled && !IsVisible(position, size)) return;
+
+        // The vertex shader finds the uvs from the sheet and the sprite index
+        appendSprite(position, size, color, texture);
+    }
+
+    void QueueSprite(DrawLayer layer, Vector2F position, Vector2F size, Texture texture, Color color, bool isCulled)
+    {
+        if (!isCulled && !IsVisible(position, size)) return;
 
-        if (object.Texture.TileSheetIndex != TileSheet::None)
+        setQueuedSprite(reserveDrawList(1), layer, position, size, texture, color);
+    }
+
+    void PlaceDrawListRanges(std::span<DrawListRange> ranges)
+    {
+        int count = 0;
+
+        for (auto& range : ranges)
         {
-            uvs = GetUvs(object.Texture);
+            count += range.Count;
         }
 
-        Vector2F position = GetTransformedPosition(object.Position, object.Pivot, object.Scale, object.Rotation, object.Size);
+        int next = reserveDrawList(count);
+
+        for (auto& range : ranges)
+        {
+            range.Next = next;
+            next += range.Count;
+        }
+    }
+
+    void FlushDrawList()
+    {
+        if (drawListUsed == 0) return;
+
+        sortDrawList();
 
-        DrawRect(position, object.Size * object.Scale, object.Color, uvs);
+        DrawCall& call = getDrawCall(DrawCallType::Sprites);
+        SpriteInstance* sorted = reserve(sprites, spritesUsed, drawListUsed);
+
+        TaskScheduler::ParallelFor(0, drawListUsed, drawListCopyGrain, [sorted](int first, int last)
+        {
+            for (int i = first; i < last; i++)
+            {
+                sorted[i] = drawListSprites[drawKeys[i].Sprite];
+            }
+        });
+
+        spritesUsed += drawListUsed;
+        call.Count += drawListUsed;
+        drawListUsed = 0;
     }
 
     void MoveCamera(Vector2F position)
     {
 		const float width = camera.ScreenSize.X;
 		const float height = camera.ScreenSize.Y;
-		const Vector2F MaxSize = { 2500, 2500};
-		const Vector2F MinSize = { -2500, -2500};
+		const Vector2F MaxSize = cameraMaxBounds;
+		const Vector2F MinSize = cameraMinBounds;
 		const Vector2F transformedMaxSize = Matrix2x3F::Multiply(transformMatrix, MaxSize);
 		const Vector2F transformedMinSize = Matrix2x3F::Multiply(transformMatrix, MinSize);
 
@@ -236,6 +548,12 @@ namespace Graphics
 		camera.ScreenSize = { width, height };
 	}
 
+	void SetCameraBounds(Vector2F min, Vector2F max)
+	{
+		cameraMinBounds = min;
+		cameraMaxBounds = max;
+	}
+
     void CalculTransformationMatrix(Vector2F scale)
     {
         transformMatrix     = Matrix2x3F::TransformMatrix(scale, 0, camera.Position, camera.Pivot);
@@ -259,21 +577,22 @@ namespace Graphics
 
     size_t GetVertexBufferSize()
     {
-        return sizeof(vertexes);
+        return vertexes.size() * sizeof(PackedVertex);
     }
 
     size_t GetIndexBufferSize()
     {
-        return sizeof(indices);
+        return indices.size() * sizeof(uint32_t);
     }
 
     void ClearFrameBuffers()
     {
         vertexesUsed = 0;
         indicesUsed = 0;
-
-		memset(vertexes, 0, sizeof(vertexes));
-		memset(indices, 0, sizeof(indices));
+        spritesUsed = 0;
+        drawCallsUsed = 0;
+        drawListUsed = 0;
+        ground.IsVisible = false;
     }
 
 	bool IsVisible(Vector2F position, Vector2F size)
@@ -291,10 +610,43 @@ namespace Graphics
 			(transformedPosition.X + transformedSize.X >= 0 && transformedPosition.X + transformedSize.X <= width && transformedPosition.Y + transformedSize.Y >= 0 && transformedPosition.Y + transformedSize.Y <= height) ||
 			(transformedPosition.X <= 0 && transformedPosition.X + transformedSize.X >= width && transformedPosition.Y <= 0 && transformedPosition.Y + transformedSize.Y >= height);
 	}
+
+	void GetVisibleArea(Vector2F& min, Vector2F& max, float margin)
+	{
+		Vector2F corners[4] = {
+			ScreenToWorld({0, 0}),
+			ScreenToWorld({camera.ScreenSize.X, 0}),
+			ScreenToWorld({0, camera.ScreenSize.Y}),
+			ScreenToWorld(camera.ScreenSize)
+		};
+
+		min = corners[0];
+		max = corners[0];
+
+		for (auto& corner : corners)
+		{
+			min = {std::min(min.X, corner.X), std::min(min.Y, corner.Y)};
+			max = {std::max(max.X, corner.X), std::max(max.Y, corner.Y)};
+		}
+
+		min -= Vector2F{margin, margin};
+		max += Vector2F{margin, margin};
+	}
 }
 
 void Serialize(Serializer* ser, Camera* camera)
 {
     Serialize(ser, &camera->Position);
     Serialize(ser, &camera->Zoom);
-}
\ No newline at end of file
+}
+
+void DrawListRange::Add(DrawLayer layer, Vector2F position, Vector2F size, Texture texture, Color color)
+{
+    if (Next == -1)
+    {
+        Count++;
+        return;
+    }
+
+    Graphics::setQueuedSprite(Next++, layer, position, size, texture, color);
+}
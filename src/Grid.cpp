@@ -1,100 +1,59 @@
-#include "map"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 #include "Grid.h"
+#include "TileDefinitions.h"
+#include "ChunkStreamer.h"
+#include "MapGenerator.h"
 #include "Graphics.h"
 #include "Random.h"
+#include "TaskScheduler.h"
 #include "Input.h"
 #include "Timer.h"
 #include "Logger.h"
 
-std::map<TileType, std::map<Items, int>> *tileMaxInventory = new std::map<TileType, std::map<Items, int>>{
-    {TileType::Sawmill, {{Items::Wood, 50}}},
-    {TileType::Storage, {{Items::Wood, 100}, {Items::Stone, 100}, {Items::Coal, 50}, {Items::IronOre, 100}, {Items::IronIngot, 20}}},
-    {TileType::LogisticsCenter, {{Items::Wood, 50}, {Items::Stone, 50}, {Items::Coal, 25}, {Items::IronOre, 50}, {Items::IronIngot, 10}}},
-    {TileType::Quarry, {{Items::Stone, 50}, {Items::Coal, 25}, {Items::IronOre, 50}}},
-    {TileType::MayorHouse, {{Items::Wood, 15}, {Items::Stone, 15}}},
-    {TileType::Furnace, {{Items::Coal, 10}, {Items::IronOre, 60}, {Items::IronIngot, 20}}},
-};
-
-// Items needed to build a tile
-std::map<TileType, std::map<Items, int>> tileNeededItems = std::map<TileType, std::map<Items, int>>{
-    {TileType::Sawmill, {{Items::Wood, 10}}},
-    {TileType::Storage, {{Items::Wood, 20}}},
-    {TileType::LogisticsCenter, {{Items::Wood, 20}, {Items::Stone, 10}}},
-    {TileType::Quarry, {{Items::Wood, 20}}},
-    {TileType::House, {{Items::Wood, 30}, {Items::Stone, 15}}},
-    {TileType::BuilderHut, {{Items::Wood, 20}, {Items::Stone, 10}}},
-    {TileType::Furnace, {{Items::Stone, 35}}},
-};
-
-Grid::Grid(int width, int height, int tileSize)
-{
-    _width = width;
-    _height = height;
-    _tileSize = tileSize;
-
-    _tiles = (Tile *)malloc(sizeof(Tile) * width * height);
-
-    for (int x = 0; x < width / tileSize; x++)
-    {
-        for (int y = 0; y < height / tileSize; y++)
-        {
-            _tiles[x + y * width] = Tile(TileType::None);
-        }
-    }
-}
-
-Texture Grid::GetTexture(TilePosition position)
-{
-    Tile &tile = GetTile(position);
-
-    switch (tile.Type)
-    {
-        case TileType::Stone: return Texture(Resources::Stone);
-        case TileType::Tree: return getTreeTexture(tile);
-        case TileType::Sawmill: return Texture(Buildings::Sawmill);
-        case TileType::Road: return getRoadTexture(position);
-        case TileType::MayorHouse: return Texture(Buildings::MayorHouse);
-        case TileType::House: return Texture(Buildings::House);
-        case TileType::BuilderHut: return Texture(Buildings::BuilderHut);
-        case TileType::Storage: return Texture(Buildings::Storage);
-        case TileType::Quarry: return Texture(Buildings::Quarry);
-        case TileType::LogisticsCenter: return Texture(Buildings::LogisticsCenter);
-        case TileType::Furnace: return tile.BurnTimer > 0.f ? Texture(Buildings::ActiveFurnace) : Texture(Buildings::InactiveFurnace);
-        default: return {};
-    }
-}
-
-Texture Grid::getTreeTexture(Tile &tile)
-{
-    if (tile.TreeGrowth < 15.f)
-    {
-        return Texture(Resources::TreeSprout);
-    }
-    else if (tile.TreeGrowth < 30.f)
-    {
-        return Texture(Resources::TreeMiddle);
-    }
-    else
-    {
-        return Texture(Resources::TreeFull);
-    }
-}
-bool Grid::IsRoad(TilePosition tp)
+// Simulation timings, in ticks
+// The trees are drawn middle sized from treeMiddleTicks and full from treeMatureTicks
+constexpr int64_t treeMiddleTicks = 15 * Timer::TicksPerSecond;
+constexpr int64_t treeMatureTicks = 30 * Timer::TicksPerSecond;
+constexpr int64_t treeSpawnTicks = 30 * Timer::TicksPerSecond;
+constexpr int64_t coalBurnTicks = 30 * Timer::TicksPerSecond;
+constexpr int64_t smeltTicks = 10 * Timer::TicksPerSecond;
+
+// Tree spawn rolls done at once by the trees of the coarse chunks
+constexpr int coarseSpawnRolls = 8;
+
+// Due events from which the tick draws the spawn rolls in parallel, and the events per task
+static constexpr int parallelEventBatch = 512;
+static constexpr int eventBlockSize = 256;
+// Rows of visible tiles queued in the draw list by a task
+static constexpr int drawBandRows = 8;
+
+// The tiles that aren't buildings are built as soon as they are set
+constexpr bool isAlwaysBuilt(TileType type)
 {
-    return IsTileValid(tp) && GetTile(tp).Type == TileType::Road;
+    return type == TileType::None || type == TileType::Tree || type == TileType::Road || type == TileType::Stone;
 }
 
-Texture Grid::getRoadTexture(TilePosition position)
+// Texture of a road for each mask of its neighbour roads, see getNeighbourMask
+constexpr Texture getRoadTextureOfMask(uint8_t mask)
 {
-    bool up = IsRoad(position + TilePosition{0, -1});
-    bool down = IsRoad(position + TilePosition{0, 1});
-    bool left = IsRoad(position + TilePosition{-1, 0});
-    bool right = IsRoad(position + TilePosition{1, 0});
-    bool upLeft = IsRoad(position + TilePosition{-1, -1});
-    bool upRight = IsRoad(position + TilePosition{1, -1});
-    bool downLeft = IsRoad(position + TilePosition{-1, 1});
-    bool downRight = IsRoad(position + TilePosition{1, 1});
+    bool up = mask & 1;
+    bool down = mask & 2;
+    bool left = mask & 4;
+    bool right = mask & 8;
+    bool upLeft = mask & 16;
+    bool upRight = mask & 32;
+    bool downLeft = mask & 64;
+    bool downRight = mask & 128;
 
     if (up && down && left && right && !upLeft && !upRight && !downLeft && !downRight) // cross
         return Texture(Road::Cross);
@@ -192,408 +151,1922 @@ Texture Grid::getRoadTexture(TilePosition position)
     return Texture(Road::Single);
 }
 
-void Grid::Draw(bool drawLandAndRoads, bool isMouseOnAWindow)
+constexpr std::array<Texture, 256> roadTextures = []()
 {
-    Random::UseSeed();
+    std::array<Texture, 256> textures;
 
-    auto mousePosition = Input::GetMousePosition();
-    Vector2F worldMousePosition = Graphics::ScreenToWorld(mousePosition);
-	TilePosition mouse = GetTilePosition(worldMousePosition);
+    for (int mask = 0; mask < 256; mask++)
+    {
+        textures[mask] = getRoadTextureOfMask((uint8_t)mask);
+    }
+
+    return textures;
+}();
+
+const Tile Grid::_emptyTile = Tile(TileType::None);
+
+Grid::Grid(int width, int height, int tileSize)
+{
+    _residentChunkBudget = 0;
+    _events = std::make_unique<TimerWheel>();
+    _seed = 0;
+    _nextChangeListenerId = 0;
+
+    Reset(width, height, tileSize);
+}
+
+// Out of line for the destructor of the streamer
+Grid::~Grid() = default;
+
+void Grid::Reset(int width, int height, int tileSize)
+{
+    releaseChunks();
+
+    _tileSize = tileSize;
+
+    // Center the world on the tile 0, 0, the shifts round toward negative infinity
+    int minTileX = -width / 2;
+    int minTileY = -height / 2;
+
+    _minChunkX = minTileX >> Chunk::Shift;
+    _minChunkY = minTileY >> Chunk::Shift;
+    _maxChunkX = ((minTileX + width - 1) >> Chunk::Shift) + 1;
+    _maxChunkY = ((minTileY + height - 1) >> Chunk::Shift) + 1;
+
+    _chunks = std::vector<ChunkSlot>((_maxChunkX - _minChunkX) * (_maxChunkY - _minChunkY));
+    _frame = 0;
+
+    _events->Reset(0);
+    _dueEvents.clear();
+
+    for (auto &tiles : _builtTiles)
+    {
+        tiles.clear();
+    }
+
+    _builtTileSlots.clear();
+    _dirtyRegions.clear();
+
+    _groundMin = {0, 0};
+    _groundMax = {-1, -1};
+    _isRenderDirty = true;
+    _nextRenderTick = INT64_MAX;
+    _drawnMouse = {0, 0};
+    _wasMouseOnAWindow = false;
+}
+
+RandomStream Grid::GetTileRandom(TilePosition position, uint64_t key) const
+{
+    return RandomStream(_seed, ((uint64_t)(uint32_t)position.X << 32) | (uint32_t)position.Y).Split(key);
+}
+
+int Grid::getChunkSlot(int chunkX, int chunkY) const
+{
+    if (chunkX < _minChunkX || chunkX >= _maxChunkX || chunkY < _minChunkY || chunkY >= _maxChunkY)
+    {
+        return -1;
+    }
+
+    return (chunkX - _minChunkX) + (chunkY - _minChunkY) * (_maxChunkX - _minChunkX);
+}
+
+Chunk* Grid::getChunk(TilePosition position) const
+{
+    // Arithmetic shifts round toward negative infinity, which is what we need for negative positions
+    int slot = getChunkSlot(position.X >> Chunk::Shift, position.Y >> Chunk::Shift);
+
+    return slot == -1 ? nullptr : _chunks[slot].Chunk.get();
+}
+
+Chunk* Grid::getOrCreateChunk(TilePosition position)
+{
+    int slot = getChunkSlot(position.X >> Chunk::Shift, position.Y >> Chunk::Shift);
+
+    assert(slot != -1 && "Tile position outside of the world");
+
+    if (_chunks[slot].IsPagedOut)
+    {
+        pageIn(slot);
+    }
+
+    if (_chunks[slot].Chunk == nullptr)
+    {
+        _chunks[slot].Chunk = std::make_unique<Chunk>();
+        _chunks[slot].Planes = std::make_unique<ChunkPlanes>();
+    }
+
+    touchChunk(slot);
+
+    return _chunks[slot].Chunk.get();
+}
+
+void Grid::releaseChunks()
+{
+    if (_streamer != nullptr)
+    {
+        int chunkX, chunkY;
+        Chunk* chunk;
+
+        _streamer->Flush();
+
+        while (_streamer->PopLoaded(chunkX, chunkY, chunk))
+        {
+            delete chunk;
+        }
+
+        _streamer->Clear();
+    }
+
+    for (auto& slot : _chunks)
+    {
+        slot = ChunkSlot();
+    }
+
+    _dirtyRegions.clear();
+
+    for (auto& tiles : _builtTiles)
+    {
+        tiles.clear();
+    }
+
+    _builtTileSlots.clear();
+    _isRenderDirty = true;
+}
+
+Vector2F Grid::GetWorldMin() const
+{
+    return Vector2F{_minChunkX, _minChunkY} * (float)(Chunk::Size * _tileSize);
+}
+
+Vector2F Grid::GetWorldMax() const
+{
+    return Vector2F{_maxChunkX, _maxChunkY} * (float)(Chunk::Size * _tileSize);
+}
+
+size_t Grid::GetAllocatedChunkCount() const
+{
+    return std::count_if(_chunks.begin(), _chunks.end(), [](const ChunkSlot& slot) { return slot.Chunk != nullptr || slot.IsPagedOut; });
+}
+
+size_t Grid::GetResidentChunkCount() const
+{
+    return std::count_if(_chunks.begin(), _chunks.end(), [](const ChunkSlot& slot) { return slot.Chunk != nullptr; });
+}
+
+void Grid::Grow(int left, int top, int right, int bottom)
+{
+    if (left == 0 && top == 0 && right == 0 && bottom == 0) return;
+
+    int newMinChunkX = _minChunkX - left;
+    int newMinChunkY = _minChunkY - top;
+    int newMaxChunkX = _maxChunkX + right;
+    int newMaxChunkY = _maxChunkY + bottom;
+
+    assert((newMaxChunkX - newMinChunkX) * Chunk::Size <= MaxWorldSize && (newMaxChunkY - newMinChunkY) * Chunk::Size <= MaxWorldSize && "World too big");
+
+    int newWidth = newMaxChunkX - newMinChunkX;
+    std::vector<ChunkSlot> chunks = std::vector<ChunkSlot>(newWidth * (newMaxChunkY - newMinChunkY));
+
+    for (int chunkY = _minChunkY; chunkY < _maxChunkY; chunkY++)
+    {
+        for (int chunkX = _minChunkX; chunkX < _maxChunkX; chunkX++)
+        {
+            chunks[(chunkX - newMinChunkX) + (chunkY - newMinChunkY) * newWidth] = std::move(_chunks[getChunkSlot(chunkX, chunkY)]);
+        }
+    }
+
+    std::unique_lock lock(_chunkTableMutex);
+
+    _chunks = std::move(chunks);
+    _minChunkX = newMinChunkX;
+    _minChunkY = newMinChunkY;
+    _maxChunkX = newMaxChunkX;
+    _maxChunkY = newMaxChunkY;
+}
+
+void Grid::GrowAround(TilePosition position)
+{
+    int chunkX = position.X >> Chunk::Shift;
+    int chunkY = position.Y >> Chunk::Shift;
+
+    Grow(
+        chunkX == _minChunkX ? 1 : 0,
+        chunkY == _minChunkY ? 1 : 0,
+        chunkX == _maxChunkX - 1 ? 1 : 0,
+        chunkY == _maxChunkY - 1 ? 1 : 0
+    );
+}
+
+void Grid::Generate(const MapGenerator &generator)
+{
+    struct GeneratedTile
+    {
+        TilePosition Position;
+        TileType Type;
+        float TreeGrowth;
+    };
+
+    int chunkCount = (int)_chunks.size();
+    int64_t tick = GetTick();
+
+    // The empty slots get a new chunk, the allocated ones get their empty tiles filled afterwards
+    std::vector<Chunk*> newChunks(chunkCount, nullptr);
+    std::vector<std::vector<GeneratedTile>> newTiles(chunkCount);
+    // Indexes of the tiles generated in the new chunks, the rest of their tiles is grass and needs nothing
+    std::vector<std::vector<uint16_t>> generatedTiles(chunkCount);
+
+    // The tasks only read the grid and write their own slots
+    TaskScheduler::ParallelForChunks(_minChunkX, _minChunkY, _maxChunkX, _maxChunkY, [&](int chunkX, int chunkY)
+    {
+        int slot = getChunkSlot(chunkX, chunkY);
+
+        if (_chunks[slot].IsPagedOut) return;
+
+        bool isAllocated = _chunks[slot].Chunk != nullptr;
+        TileType types[Chunk::Size];
+        float treeGrowths[Chunk::Size];
+
+        for (int y = 0; y < Chunk::Size; y++)
+        {
+            generator.GetRowTiles(chunkX, chunkY * Chunk::Size + y, types, treeGrowths);
+
+            for (int x = 0; x < Chunk::Size; x++)
+            {
+                if (types[x] == TileType::None) continue;
+
+                int i = x + y * Chunk::Size;
+                TilePosition position = {chunkX * Chunk::Size + x, chunkY * Chunk::Size + y};
+
+                if (isAllocated)
+                {
+                    if (_chunks[slot].Chunk->Tiles[i].Type == TileType::None)
+                    {
+                        newTiles[slot].push_back({position, types[x], treeGrowths[x]});
+                    }
+
+                    continue;
+                }
+
+                if (newChunks[slot] == nullptr)
+                {
+                    newChunks[slot] = new Chunk();
+                }
+
+                Tile &tile = newChunks[slot]->Tiles[i];
+
+                tile.Type = types[x];
+                tile.IsBuilt = true;
+                startTile(tile, tick);
+                tile.TreePlantedTick = tick - (int64_t)(treeGrowths[x] * Timer::TicksPerSecond);
+                generatedTiles[slot].push_back((uint16_t)i);
+            }
+        }
+    });
+
+    // The generated tiles are all built, their lists grow once rather than rehashing along the way
+    size_t generatedTileCount = 0;
+
+    for (auto &indexes : generatedTiles)
+    {
+        generatedTileCount += indexes.size();
+    }
+
+    _builtTileSlots.reserve(_builtTileSlots.size() + generatedTileCount);
+
+    for (int slot = 0; slot < chunkCount; slot++)
+    {
+        if (newChunks[slot] == nullptr) continue;
+
+        {
+            std::unique_lock lock(_chunkTableMutex);
+
+            _chunks[slot].Chunk.reset(newChunks[slot]);
+            _chunks[slot].Planes = std::make_unique<ChunkPlanes>();
+        }
+
+        touchChunk(slot);
+
+        int chunkX = _minChunkX + slot % (_maxChunkX - _minChunkX);
+        int chunkY = _minChunkY + slot / (_maxChunkX - _minChunkX);
+
+        for (int i : generatedTiles[slot])
+        {
+            TilePosition position = {chunkX * Chunk::Size + i % Chunk::Size, chunkY * Chunk::Size + i / Chunk::Size};
+
+            trackTile(newChunks[slot]->Tiles[i], position);
+            scheduleTileEvents(newChunks[slot]->Tiles[i], position);
+        }
+
+        markChunkChanged(slot, TileChange::All);
+    }
+
+    for (auto &tiles : newTiles)
+    {
+        for (auto &tile : tiles)
+        {
+            SetTile(tile.Position, Tile(tile.Type));
+
+            if (tile.Type == TileType::Tree)
+            {
+                SetTreeGrowth(tile.Position, tile.TreeGrowth);
+            }
+        }
+    }
+}
+
+Texture Grid::GetTexture(TilePosition position)
+{
+    const Tile &tile = PeekTile(position);
+
+    switch (tile.Type)
+    {
+        case TileType::Tree: return getTreeTexture(tile);
+        case TileType::Road: return getRoadTexture(position);
+        case TileType::Furnace: return IsBurning(tile) ? Texture(Buildings::ActiveFurnace) : Texture(Buildings::InactiveFurnace);
+        default: return GetTileDefinition(tile.Type).BaseTexture;
+    }
+}
+
+Texture Grid::getTreeTexture(const Tile &tile) const
+{
+    int64_t age = GetTick() - tile.TreePlantedTick;
+
+    if (age < treeMiddleTicks)
+    {
+        return Texture(Resources::TreeSprout);
+    }
+    else if (age < treeMatureTicks)
+    {
+        return Texture(Resources::TreeMiddle);
+    }
+    else
+    {
+        return Texture(Resources::TreeFull);
+    }
+}
+
+ChunkRender* Grid::getChunkRender(int slot)
+{
+    ChunkSlot &chunkSlot = _chunks[slot];
+
+    if (chunkSlot.Render == nullptr)
+    {
+        chunkSlot.Render = std::make_unique<ChunkRender>();
+    }
+
+    ChunkRender* render = chunkSlot.Render.get();
+
+    // A tree reached its next stage, the trees are resolved again
+    if (GetTick() >= render->NextTreeStageTick)
+    {
+        for (int row = 0; row < Chunk::Size && chunkSlot.Planes != nullptr; row++)
+        {
+            render->DirtyRows[row] |= chunkSlot.Planes->Rows[(int)TileType::Tree][row];
+        }
+
+        render->NextTreeStageTick = INT64_MAX;
+        render->IsDirty = true;
+    }
 
-    for (int x = 0; x < _width / _tileSize; x++)
+    if (!render->IsDirty) return render;
+
+    int chunkX = _minChunkX + slot % (_maxChunkX - _minChunkX);
+    int chunkY = _minChunkY + slot / (_maxChunkX - _minChunkX);
+    Chunk* chunk = chunkSlot.Chunk.get();
+
+    for (int y = 0; y < Chunk::Size; y++)
     {
-        for (int y = 0; y < _height / _tileSize; y++)
+        for (uint64_t dirty = render->DirtyRows[y]; dirty != 0; dirty &= dirty - 1)
         {
-            Tile &tile = _tiles[x + y * _width];
-            auto position = Vector2F{x, y} * _tileSize - Vector2F{_width, _height} / 2.f;
-            auto size = Vector2F{(float)_tileSize, (float)_tileSize};
-            auto randomLand = Texture((Land)Random::Range(1, (int)Land::Count - 1));
-            auto background = tile.Type != TileType::None ? Texture(Land::Grass) : randomLand;
+            int i = std::countr_zero(dirty) + y * Chunk::Size;
+            const Tile &tile = chunk != nullptr ? chunk->Tiles[i] : _emptyTile;
+            TilePosition position = {chunkX * Chunk::Size + (i & (Chunk::Size - 1)), chunkY * Chunk::Size + y};
 
-            if (tile.Type != TileType::Road && drawLandAndRoads)
+            // The flowers only depend on the seed and the position, they are the same every time the tile is resolved
+            render->Backgrounds[i] = tile.Type != TileType::None ? Texture(Land::Grass) : Texture((Land)GetTileRandom(position, 0).Range(1, (int)Land::Count - 1));
+            render->Sprites[i] = tile.Type != TileType::None ? GetTexture(position) : Texture();
+
+            if (isInGround(position))
             {
-                Graphics::DrawObject({
-                    .Position = position,
-                    .Size = size,
-                    .Texture = background
-                });
+                setGroundTile(position, *render, i);
             }
 
-            if (tile.Type != TileType::None)
+            if (tile.Type == TileType::Tree)
             {
-				if (drawLandAndRoads)
-				{
-					if (!tile.IsBuilt)
-					{
-						Graphics::DrawRect(position, size, Color(1, 1, 0, 1.f - tile.Progress / GetMaxConstructionProgress(tile.Type)));
-					}
-					else if (tile.NeedToBeDestroyed)
-					{
-						Graphics::DrawRect(position, size, Color(1, 0, 0, 1.f - tile.Progress / GetMaxDestructionProgress(tile.Type)));
-					}
-				}
-
-				if (tile.Type == TileType::Road && drawLandAndRoads || !drawLandAndRoads && tile.Type != TileType::Road)
-				{
-					Graphics::DrawObject({
-						.Position = position,
-						.Size = size,
-						.Texture = GetTexture({x, y})
-					});
-				}
+                int64_t age = GetTick() - tile.TreePlantedTick;
+                int64_t stageTick = tile.TreePlantedTick + (age < treeMiddleTicks ? treeMiddleTicks : treeMatureTicks);
+
+                if (age < treeMatureTicks)
+                {
+                    render->NextTreeStageTick = std::min(render->NextTreeStageTick, stageTick);
+                }
             }
+        }
+
+        render->DirtyRows[y] = 0;
+    }
+
+    render->IsDirty = false;
+
+    return render;
+}
+
+void Grid::setGroundTile(TilePosition position, const ChunkRender &render, int tileIndex)
+{
+    const Texture &sprite = render.Sprites[tileIndex];
+
+    Graphics::SetGroundTile(position.X, position.Y, sprite.TileSheetIndex == TileSheet::Road ? sprite : render.Backgrounds[tileIndex]);
+}
+
+bool Grid::isInGround(TilePosition position) const
+{
+    return position.X >= _groundMin.X && position.X <= _groundMax.X && position.Y >= _groundMin.Y && position.Y <= _groundMax.Y;
+}
+
+void Grid::invalidateRender(const DirtyRegion &region)
+{
+    // The inventories and the progress aren't in the sprites
+    if (!HasChange(region.Changes, TileChange::Type | TileChange::TreeGrowth | TileChange::Furnace)) return;
+
+    TilePosition min = region.Min;
+    TilePosition max = region.Max;
+
+    // The roads around a tile that changed type change with it
+    if (HasChange(region.Changes, TileChange::Type))
+    {
+        min = {std::max(min.X - 1, GetMinTilePosition().X), std::max(min.Y - 1, GetMinTilePosition().Y)};
+        max = {std::min(max.X + 1, GetMaxTilePosition().X - 1), std::min(max.Y + 1, GetMaxTilePosition().Y - 1)};
+    }
+
+    for (int chunkY = min.Y >> Chunk::Shift; chunkY <= max.Y >> Chunk::Shift; chunkY++)
+    {
+        for (int chunkX = min.X >> Chunk::Shift; chunkX <= max.X >> Chunk::Shift; chunkX++)
+        {
+            ChunkRender* render = _chunks[getChunkSlot(chunkX, chunkY)].Render.get();
+
+            if (render == nullptr) continue;
 
-            if (!drawLandAndRoads && mouse == TilePosition{x, y} && !isMouseOnAWindow)
+            int firstBit = std::max(min.X - chunkX * Chunk::Size, 0);
+            int lastBit = std::min(max.X - chunkX * Chunk::Size, Chunk::Size - 1);
+            int firstRow = std::max(min.Y - chunkY * Chunk::Size, 0);
+            int lastRow = std::min(max.Y - chunkY * Chunk::Size, Chunk::Size - 1);
+            uint64_t columns = (~uint64_t(0) << firstBit) & (~uint64_t(0) >> (Chunk::Size - 1 - lastBit));
+
+            for (int row = firstRow; row <= lastRow; row++)
             {
-                Graphics::DrawRect(
-                    position,
-                    Vector2F{(float)_tileSize, (float)_tileSize},
-                    Color(1, 1, 1, 0.2f)
-				);
+                render->DirtyRows[row] |= columns;
             }
+
+            render->IsDirty = true;
         }
     }
+}
+
+bool Grid::IsRoad(TilePosition tp)
+{
+    return PeekTile(tp).Type == TileType::Road;
+}
+
+uint8_t Grid::getNeighbourMask(TilePosition position, TileType type) const
+{
+    static constexpr TilePosition offsets[8] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}, {-1, -1}, {1, -1}, {-1, 1}, {1, 1}};
+
+    Chunk* chunk = getChunk(position);
+    int x = position.X & (Chunk::Size - 1);
+    int y = position.Y & (Chunk::Size - 1);
+    uint8_t mask = 0;
+
+    // Away from the borders of the chunk the neighbours are in the same tile array, no bounds or chunk to check
+    if (chunk != nullptr && x > 0 && x < Chunk::Size - 1 && y > 0 && y < Chunk::Size - 1)
+    {
+        const Tile* tile = &chunk->Tiles[x + y * Chunk::Size];
+
+        for (int i = 0; i < 8; i++)
+        {
+            mask |= (tile[offsets[i].X + offsets[i].Y * Chunk::Size].Type == type) << i;
+        }
+
+        return mask;
+    }
+
+    // Outside of the world PeekTile gives grass, like a border around it
+    for (int i = 0; i < 8; i++)
+    {
+        mask |= (PeekTile(position + offsets[i]).Type == type) << i;
+    }
+
+    return mask;
+}
+
+Texture Grid::getRoadTexture(TilePosition position)
+{
+    return roadTextures[getNeighbourMask(position, TileType::Road)];
+}
+
+void Grid::Draw(bool isMouseOnAWindow)
+{
+    auto mousePosition = Input::GetMousePosition();
+    Vector2F worldMousePosition = Graphics::ScreenToWorld(mousePosition);
+	TilePosition mouse = GetTilePosition(worldMousePosition);
+    auto size = Vector2F{(float)_tileSize, (float)_tileSize};
+
+    // Only the tiles seen by the camera are visited, they don't need the visibility test of each quad
+    TilePosition min, max;
+    GetVisibleTiles(min, max);
+
+    // The tilemap pass draws the land and the roads when its window covers the screen.
+    // The sprites are written to it when they change or come into view, the others stay from the previous frames
+    bool isGroundMapped = Graphics::isGroundMapEnabled && max.X - min.X < Graphics::groundMapSize && max.Y - min.Y < Graphics::groundMapSize;
+    TilePosition previousGroundMin = _groundMin;
+    TilePosition previousGroundMax = _groundMax;
+
+    _groundMin = isGroundMapped ? min : TilePosition{0, 0};
+    _groundMax = isGroundMapped ? max : TilePosition{-1, -1};
+    _isRenderDirty = false;
+    _nextRenderTick = INT64_MAX;
+    _drawnMouse = mouse;
+    _wasMouseOnAWindow = isMouseOnAWindow;
+
+    if (isGroundMapped)
+    {
+        Graphics::DrawGround(GetWorldMin(), GetWorldMax(), (float)_tileSize);
+    }
+
+    // The sprites of the chunks are resolved first, the bands of rows only read them
+    for (int chunkY = min.Y >> Chunk::Shift; chunkY <= max.Y >> Chunk::Shift; chunkY++)
+    {
+        for (int chunkX = min.X >> Chunk::Shift; chunkX <= max.X >> Chunk::Shift; chunkX++)
+        {
+            const ChunkRender* render = getChunkRender(getChunkSlot(chunkX, chunkY));
+
+            _nextRenderTick = std::min(_nextRenderTick, render->NextTreeStageTick);
+        }
+    }
+
+    if (isGroundMapped)
+    {
+        writeNewGroundTiles(previousGroundMin, previousGroundMax);
+    }
+
+    if (max.Y < min.Y || max.X < min.X) return;
+
+    // Each tile is visited once, the layers of the draw list put its sprites in the right order
+    auto queueBand = [&](int band)
+    {
+        DrawListRange& range = _drawBands[band];
+        int lastY = std::min(min.Y + (band + 1) * drawBandRows - 1, max.Y);
+
+        for (int tileY = min.Y + band * drawBandRows; tileY <= lastY; tileY++)
+        {
+            int chunkY = tileY >> Chunk::Shift;
+            int y = tileY & (Chunk::Size - 1);
+
+            for (int chunkX = min.X >> Chunk::Shift; chunkX <= max.X >> Chunk::Shift; chunkX++)
+            {
+                const ChunkSlot& chunkSlot = _chunks[getChunkSlot(chunkX, chunkY)];
+                const ChunkRender* render = chunkSlot.Render.get();
+
+                int minX = std::max(min.X - chunkX * Chunk::Size, 0);
+                int maxX = std::min(max.X - chunkX * Chunk::Size, Chunk::Size - 1);
+
+                for (int x = minX; x <= maxX; x++)
+                {
+                    int i = x + y * Chunk::Size;
+                    const Tile &tile = chunkSlot.Chunk != nullptr ? chunkSlot.Chunk->Tiles[i] : _emptyTile;
+                    TilePosition tilePosition = {chunkX * Chunk::Size + x, tileY};
+                    auto position = ToWorldPosition(tilePosition);
+
+                    if (!isGroundMapped)
+                    {
+                        Texture ground = tile.Type == TileType::Road ? render->Sprites[i] : render->Backgrounds[i];
+                        range.Add(DrawLayer::Ground, position, size, ground);
+                    }
+
+                    if (tile.Type != TileType::None)
+                    {
+                        if (!tile.IsBuilt)
+                        {
+                            range.Add(DrawLayer::GroundOverlay, position, size, Texture(), Color(1, 1, 0, 1.f - tile.Progress / GetMaxConstructionProgress(tile.Type)));
+                        }
+                        else if (tile.NeedToBeDestroyed)
+                        {
+                            range.Add(DrawLayer::GroundOverlay, position, size, Texture(), Color(1, 0, 0, 1.f - tile.Progress / GetMaxDestructionProgress(tile.Type)));
+                        }
+
+                        if (tile.Type != TileType::Road)
+                        {
+                            range.Add(DrawLayer::Objects, position, size, render->Sprites[i]);
+                        }
+                    }
+
+                    if (mouse == tilePosition && !isMouseOnAWindow)
+                    {
+                        range.Add(DrawLayer::Cursor, position, size, Texture(), Color(1, 1, 1, 0.2f));
+                    }
+                }
+            }
+        }
+    };
+
+    // The bands count their sprites, then write them where the sprites of the bands before them end
+    int bandCount = (max.Y - min.Y) / drawBandRows + 1;
+    _drawBands.assign(bandCount, {});
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        TaskScheduler::ParallelFor(0, bandCount, 1, [&](int firstBand, int lastBand)
+        {
+            for (int band = firstBand; band < lastBand; band++)
+            {
+                queueBand(band);
+            }
+        });
+
+        if (pass == 0)
+        {
+            Graphics::PlaceDrawListRanges(_drawBands);
+        }
+    }
+}
+
+bool Grid::IsRenderDirty(bool isMouseOnAWindow) const
+{
+    if (_isRenderDirty || GetTick() >= _nextRenderTick) return true;
+
+    // The tile under the mouse is highlighted
+    TilePosition mouse = GetTilePosition(Graphics::ScreenToWorld(Input::GetMousePosition()));
+
+    return isMouseOnAWindow != _wasMouseOnAWindow || (!isMouseOnAWindow && mouse != _drawnMouse);
+}
+
+void Grid::writeNewGroundTiles(TilePosition previousMin, TilePosition previousMax)
+{
+    // Only the tiles out of the previous window, its rows are split in the tiles on its left and on its right
+    for (int y = _groundMin.Y; y <= _groundMax.Y; y++)
+    {
+        bool isRowInPrevious = y >= previousMin.Y && y <= previousMax.Y;
+        int spans[2][2] = {{_groundMin.X, _groundMax.X}, {0, -1}};
+
+        if (isRowInPrevious)
+        {
+            spans[0][1] = std::min(_groundMax.X, previousMin.X - 1);
+            spans[1][0] = std::max(_groundMin.X, previousMax.X + 1);
+            spans[1][1] = _groundMax.X;
+        }
+
+        for (auto& span : spans)
+        {
+            for (int x = span[0]; x <= span[1]; x++)
+            {
+                const ChunkRender* render = _chunks[getChunkSlot(x >> Chunk::Shift, y >> Chunk::Shift)].Render.get();
+
+                setGroundTile({x, y}, *render, (x & (Chunk::Size - 1)) + (y & (Chunk::Size - 1)) * Chunk::Size);
+            }
+        }
+    }
+}
+
+void Grid::GetVisibleTiles(TilePosition &min, TilePosition &max) const
+{
+    Vector2F viewMin, viewMax;
+
+    // A tile of margin for the sprites that go past their tile
+    Graphics::GetVisibleArea(viewMin, viewMax, (float)_tileSize);
+
+    TilePosition worldMin = GetMinTilePosition();
+    TilePosition worldMax = GetMaxTilePosition();
+
+    min = GetTilePosition(viewMin);
+    max = GetTilePosition(viewMax);
+    min = {std::max(min.X, worldMin.X), std::max(min.Y, worldMin.Y)};
+    max = {std::min(max.X, worldMax.X - 1), std::min(max.Y, worldMax.Y - 1)};
+}
+
+void Grid::Update()
+{
+    if (_streamer != nullptr)
+    {
+        int chunkX, chunkY;
+        Chunk* chunk;
+
+        while (_streamer->PopLoaded(chunkX, chunkY, chunk))
+        {
+            installChunk(chunkX, chunkY, chunk);
+        }
+
+        pageOutLeastRecentlyUsed();
+    }
+
+    demoteChunks();
+
+    _frame++;
+}
+
+void Grid::Tick()
+{
+    // Only the tiles with an event due are updated, the others cost nothing
+    _events->Advance(_dueEvents);
+
+    // The spawn rolls of the big batches, like the catch up of the chunks coming back, are drawn in parallel.
+    // They only read the grid and use the random streams of their tiles, so the split doesn't change the results
+    if ((int)_dueEvents.size() >= parallelEventBatch)
+    {
+        _spawnRolls.resize(_dueEvents.size());
+
+        TaskScheduler::ParallelFor(0, (int)_dueEvents.size(), eventBlockSize, [this](int firstEvent, int lastEvent)
+        {
+            for (int i = firstEvent; i < lastEvent; i++)
+            {
+                TilePosition position = GetTilePosition(_dueEvents[i].Target);
+                Tile* tile = getResidentTile(position);
+
+                _spawnRolls[i] = {};
+
+                if ((TileEvent)_dueEvents[i].Type == TileEvent::TreeSpawnRoll && tile != nullptr && tile->Type == TileType::Tree)
+                {
+                    _spawnRolls[i] = rollSpawns(*tile, position);
+                }
+            }
+        });
+    }
+
+    // The events scheduled while firing are due at the next tick at the earliest
+    for (size_t i = 0; i < _dueEvents.size(); i++)
+    {
+        fireEvent(_dueEvents[i], _spawnRolls.empty() ? nullptr : &_spawnRolls[i]);
+    }
+
+    _dueEvents.clear();
+    _spawnRolls.clear();
+}
+
+Tile* Grid::getResidentTile(TilePosition position) const
+{
+    // Unlike GetTile, it doesn't load the chunk or keep it in memory
+    Chunk* chunk = getChunk(position);
+
+    if (chunk == nullptr)
+    {
+        return nullptr;
+    }
+
+    return &chunk->Tiles[(position.X & (Chunk::Size - 1)) + (position.Y & (Chunk::Size - 1)) * Chunk::Size];
+}
+
+void Grid::startTile(Tile &tile, int64_t tick)
+{
+    tile.TreePlantedTick = 0;
+    tile.TreeNextSpawnTick = 0;
+    tile.BurnEndTick = 0;
+    tile.SmeltEndTick = 0;
+    tile.SmeltTicksLeft = 0;
+
+    if (tile.Type == TileType::Tree)
+    {
+        tile.TreePlantedTick = tick;
+        tile.TreeNextSpawnTick = tick + treeSpawnTicks;
+    }
+}
+
+void Grid::scheduleTileEvents(const Tile &tile, TilePosition position)
+{
+    if (tile.Type == TileType::Tree)
+    {
+        // Trees that matured while their chunk was paged out missed their event
+        if (GetTreeGrowth(tile) >= 30.f)
+        {
+            setPlaneBit(position, ChunkPlanes::MatureTree, true);
+        }
+        else
+        {
+            scheduleEvent(tile.TreePlantedTick + treeMatureTicks, position, TileEvent::TreeMatures);
+        }
+
+        scheduleSpawnRoll(tile, position);
+    }
+    else if (tile.Type == TileType::Furnace)
+    {
+        if (tile.BurnEndTick != 0)
+        {
+            scheduleEvent(tile.BurnEndTick, position, TileEvent::CoalBurnsOut);
+        }
+
+        if (tile.SmeltEndTick != 0)
+        {
+            scheduleEvent(tile.SmeltEndTick, position, TileEvent::IngotFinishes);
+        }
+
+        scheduleEvent(GetTick() + 1, position, TileEvent::Wake);
+    }
+}
+
+void Grid::scheduleEvent(int64_t tick, TilePosition position, TileEvent event)
+{
+    _events->Schedule({tick, GetTileIndex(position), (int)event});
+}
+
+void Grid::scheduleSpawnRoll(const Tile &tile, TilePosition position)
+{
+    int64_t tick = tile.TreeNextSpawnTick;
+
+    // The coarse trees wait for several rolls to be due and do them at once
+    if (!IsDetailed(position))
+    {
+        tick += (coarseSpawnRolls - 1) * treeSpawnTicks;
+    }
+
+    scheduleEvent(tick, position, TileEvent::TreeSpawnRoll);
+}
+
+void Grid::fireEvent(const TimerEvent &event, const SpawnRolls* spawnRolls)
+{
+    TilePosition position = GetTilePosition(event.Target);
+    Tile* tile = getResidentTile(position);
+
+    // The events of the paged out chunks are scheduled again when they come back
+    if (tile == nullptr) return;
+
+    // An event is stale when the tile changed since it was scheduled, the tile keeps the ticks of its pending events
+    switch ((TileEvent)event.Type)
+    {
+        case TileEvent::TreeMatures:
+            if (tile->Type == TileType::Tree && GetTreeGrowth(*tile) >= 30.f)
+            {
+                setPlaneBit(position, ChunkPlanes::MatureTree, true);
+                markChanged(position, TileChange::TreeGrowth);
+            }
+            break;
+
+        case TileEvent::TreeSpawnRoll:
+        {
+            if (tile->Type != TileType::Tree || tile->TreeNextSpawnTick > GetTick()) break;
+
+            // Drawn before the tick if the tile didn't change since
+            SpawnRolls rolls = spawnRolls != nullptr && spawnRolls->IsRolled && spawnRolls->FirstRollTick == tile->TreeNextSpawnTick
+                ? *spawnRolls
+                : rollSpawns(*tile, position);
+
+            while (tile->TreeNextSpawnTick <= GetTick())
+            {
+                tile->TreeNextSpawnTick += treeSpawnTicks;
+            }
+
+            scheduleSpawnRoll(*tile, position);
+            spawnTrees(position, rolls);
+            break;
+        }
+
+        case TileEvent::CoalBurnsOut:
+            if (tile->Type != TileType::Furnace || tile->BurnEndTick != event.DueTick) break;
+
+            tile->BurnEndTick = 0;
+
+            // Smelting stops with the fire and goes on when the furnace is lit again
+            if (tile->SmeltEndTick != 0 && tile->SmeltEndTick <= event.DueTick)
+            {
+                tile->Inventory.at(Items::IronIngot)++;
+            }
+            else if (tile->SmeltEndTick != 0)
+            {
+                tile->SmeltTicksLeft = tile->SmeltEndTick - event.DueTick;
+            }
+
+            tile->SmeltEndTick = 0;
+
+            updateFurnace(*tile, position, event.DueTick);
+            setItemBits(*tile, position);
+            markChanged(position, TileChange::Furnace | TileChange::Inventory);
+            break;
+
+        case TileEvent::IngotFinishes:
+            if (tile->Type != TileType::Furnace || tile->SmeltEndTick != event.DueTick) break;
+
+            tile->SmeltEndTick = 0;
+            tile->Inventory.at(Items::IronIngot)++;
+
+            updateFurnace(*tile, position, event.DueTick);
+            setItemBits(*tile, position);
+            markChanged(position, TileChange::Furnace | TileChange::Inventory);
+            break;
+
+        case TileEvent::Wake:
+            if (tile->Type == TileType::Furnace)
+            {
+                updateFurnace(*tile, position, GetTick());
+                setItemBits(*tile, position);
+            }
+            break;
+    }
+}
+
+SpawnRolls Grid::rollSpawns(const Tile &tile, TilePosition position) const
+{
+    SpawnRolls spawnRolls;
+
+    if (tile.TreeNextSpawnTick > GetTick()) return spawnRolls;
+
+    // Several rolls are due for the coarse chunks and the chunks that were paged out
+    int rolls = (int)((GetTick() - tile.TreeNextSpawnTick) / treeSpawnTicks) + 1;
+    // Have a 1% chance per roll to spawn a tree on each neighbour tile
+    float chance = 1.f - std::pow(0.99f, (float)rolls);
+    RandomStream random = GetTileRandom(position, tile.TreeNextSpawnTick);
+
+    spawnRolls.IsRolled = true;
+    spawnRolls.FirstRollTick = tile.TreeNextSpawnTick;
+
+    // Always the same draws whatever the neighbours are, they can change before the rolls are applied
+    for (int i = 0; i < 4; i++)
+    {
+        if (random.Range(0.f, 1.f) < chance)
+        {
+            spawnRolls.Neighbours |= 1 << i;
+        }
+
+        // Planted at one of the rolls so it has the age it would have had
+        spawnRolls.PlantedTicks[i] = spawnRolls.FirstRollTick + random.Range(0, rolls - 1) * treeSpawnTicks;
+    }
+
+    return spawnRolls;
+}
+
+void Grid::spawnTrees(TilePosition position, const SpawnRolls &spawnRolls)
+{
+    const TilePosition offsets[4] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+
+    for (int i = 0; i < 4; i++)
+    {
+        TilePosition neighbour = position + offsets[i];
+
+        if ((spawnRolls.Neighbours & (1 << i)) == 0 || !IsTileValid(neighbour)) continue;
+        if (PeekTile(neighbour).Type != TileType::None || isPagedOut(neighbour)) continue;
+
+        Tile &tileNeighbour = GetTile(neighbour);
+
+        untrackTile(tileNeighbour, neighbour);
+
+        tileNeighbour.Type = TileType::Tree;
+        startTile(tileNeighbour, spawnRolls.PlantedTicks[i]);
+
+        trackTile(tileNeighbour, neighbour);
+        scheduleTileEvents(tileNeighbour, neighbour);
+        markChanged(neighbour, TileChange::Type | TileChange::TreeGrowth);
+    }
+}
+
+void Grid::updateFurnace(Tile &tile, TilePosition position, int64_t tick)
+{
+    if (tile.BurnEndTick == 0 && tile.Inventory.at(Items::Coal) > 0 && tile.Inventory.at(Items::IronOre) > 3)
+    {
+        tile.Inventory.at(Items::Coal)--;
+        tile.BurnEndTick = tick + coalBurnTicks;
+        scheduleEvent(tile.BurnEndTick, position, TileEvent::CoalBurnsOut);
+        markChanged(position, TileChange::Furnace | TileChange::Inventory);
+    }
+
+    // Can melt some things
+    if (tile.BurnEndTick == 0 || tile.SmeltEndTick != 0) return;
+
+    if (tile.SmeltTicksLeft > 0)
+    {
+        tile.SmeltEndTick = tick + tile.SmeltTicksLeft;
+        tile.SmeltTicksLeft = 0;
+    }
+    // Check if he has enough items to smelt
+    else if (tile.Inventory.at(Items::IronOre) > 3 && tile.Inventory.at(Items::IronIngot) < GetMaxItemsStored(tile, Items::IronIngot))
+    {
+        tile.Inventory.at(Items::IronOre) -= 3;
+        tile.SmeltEndTick = tick + smeltTicks;
+    }
+    else
+    {
+        return;
+    }
+
+    scheduleEvent(tile.SmeltEndTick, position, TileEvent::IngotFinishes);
+    markChanged(position, TileChange::Furnace | TileChange::Inventory);
+}
+
+float Grid::GetTreeGrowth(const Tile &tile) const
+{
+    return std::min((float)(GetTick() - tile.TreePlantedTick) / Timer::TicksPerSecond, 30.f);
+}
+
+bool Grid::IsBurning(const Tile &tile) const
+{
+    return tile.BurnEndTick != 0;
+}
+
+void Grid::WakeTile(TilePosition position)
+{
+    scheduleEvent(GetTick() + 1, position, TileEvent::Wake);
+}
+
+int Grid::SubscribeToChanges(TileChangeListener listener)
+{
+    _changeListeners.emplace_back(_nextChangeListenerId, std::move(listener));
+
+    return _nextChangeListenerId++;
+}
+
+void Grid::UnsubscribeFromChanges(int id)
+{
+    std::erase_if(_changeListeners, [id](const auto& listener) { return listener.first == id; });
+}
+
+void Grid::PublishChanges()
+{
+    if (_dirtyRegions.empty()) return;
+
+    // The changes made by the listeners are recorded in the next batch
+    _publishedRegions.swap(_dirtyRegions);
+    _dirtyRegions.clear();
+
+    TileChangeBatch batch = {GetTick(), _publishedRegions, TileChange::None};
+
+    for (auto &region : _publishedRegions)
+    {
+        _chunks[getChunkSlot(region.Min.X >> Chunk::Shift, region.Min.Y >> Chunk::Shift)].DirtyRegionIndex = -1;
+        batch.Changes = batch.Changes | region.Changes;
+
+        invalidateRender(region);
+    }
+
+    // Only the inventories aren't drawn
+    _isRenderDirty |= HasChange(batch.Changes, TileChange::Type | TileChange::Built | TileChange::Destruction | TileChange::Progress | TileChange::TreeGrowth | TileChange::Furnace);
+
+    for (auto &listener : _changeListeners)
+    {
+        listener.second(batch);
+    }
+}
+
+void Grid::markChanged(TilePosition position, TileChange changes)
+{
+    int &index = _chunks[getChunkSlot(position.X >> Chunk::Shift, position.Y >> Chunk::Shift)].DirtyRegionIndex;
+
+    if (index == -1)
+    {
+        index = (int)_dirtyRegions.size();
+        _dirtyRegions.push_back({position, position, changes});
+        return;
+    }
+
+    DirtyRegion &region = _dirtyRegions[index];
+
+    region.Min = {std::min(region.Min.X, position.X), std::min(region.Min.Y, position.Y)};
+    region.Max = {std::max(region.Max.X, position.X), std::max(region.Max.Y, position.Y)};
+    region.Changes = region.Changes | changes;
+}
+
+void Grid::markChunkChanged(int slot, TileChange changes)
+{
+    TilePosition min = {(_minChunkX + slot % (_maxChunkX - _minChunkX)) * Chunk::Size, (_minChunkY + slot / (_maxChunkX - _minChunkX)) * Chunk::Size};
+
+    markChanged(min, changes);
+    markChanged(min + TilePosition{Chunk::Size - 1, Chunk::Size - 1}, changes);
+}
+
+void Grid::trackTile(const Tile &tile, TilePosition position)
+{
+    if (tile.Type == TileType::None) return;
+
+    setPlaneBit(position, (int)tile.Type, true);
+    setPlaneBit(position, ChunkPlanes::MarkedForDestruction, tile.NeedToBeDestroyed);
+    setPlaneBit(position, ChunkPlanes::MatureTree, tile.Type == TileType::Tree && GetTreeGrowth(tile) >= 30.f);
+    setItemBits(tile, position);
+
+    if (!tile.IsBuilt) return;
+
+    setPlaneBit(position, ChunkPlanes::Built, true);
+
+    auto &tiles = _builtTiles[(int)tile.Type];
+
+    _builtTileSlots[GetTileIndex(position)] = (int)tiles.size();
+    tiles.push_back(position);
+}
+
+void Grid::untrackTile(const Tile &tile, TilePosition position)
+{
+    if (tile.Type == TileType::None) return;
+
+    setPlaneBit(position, (int)tile.Type, false);
+    setPlaneBit(position, ChunkPlanes::Built, false);
+    setPlaneBit(position, ChunkPlanes::MarkedForDestruction, false);
+    setPlaneBit(position, ChunkPlanes::MatureTree, false);
+
+    for (int i = 0; i < (int)Items::Count; i++)
+    {
+        setPlaneBit(position, ChunkPlanes::FirstItem + i, false);
+    }
+
+    auto it = _builtTileSlots.find(GetTileIndex(position));
+
+    if (it == _builtTileSlots.end()) return;
+
+    // Swap with the last tile of the list
+    auto &tiles = _builtTiles[(int)tile.Type];
+    int slot = it->second;
+
+    _builtTileSlots.erase(it);
+
+    if (slot != (int)tiles.size() - 1)
+    {
+        tiles[slot] = tiles.back();
+        _builtTileSlots[GetTileIndex(tiles[slot])] = slot;
+    }
+
+    tiles.pop_back();
+}
+
+void Grid::rebuildTracking()
+{
+    for (auto &tiles : _builtTiles)
+    {
+        tiles.clear();
+    }
+
+    _builtTileSlots.clear();
+
+    for (auto &slot : _chunks)
+    {
+        if (slot.Planes != nullptr)
+        {
+            *slot.Planes = ChunkPlanes();
+        }
+    }
+
+    // The loaded tiles also need their events
+    ForEachTile([&](Tile &tile, TilePosition position)
+    {
+        trackTile(tile, position);
+        scheduleTileEvents(tile, position);
+    });
+
+    // Everything changed for the listeners
+    for (int slot = 0; slot < (int)_chunks.size(); slot++)
+    {
+        if (_chunks[slot].Chunk != nullptr)
+        {
+            markChunkChanged(slot, TileChange::All);
+        }
+    }
+}
+
+void Grid::setPlaneBit(TilePosition position, int plane, bool value)
+{
+    ChunkPlanes* planes = _chunks[getChunkSlot(position.X >> Chunk::Shift, position.Y >> Chunk::Shift)].Planes.get();
+    uint64_t &row = planes->Rows[plane][position.Y & (Chunk::Size - 1)];
+    uint64_t bit = uint64_t(1) << (position.X & (Chunk::Size - 1));
+
+    row = value ? row | bit : row & ~bit;
+}
+
+void Grid::setItemBits(const Tile &tile, TilePosition position)
+{
+    for (auto &item : tile.Inventory)
+    {
+        setPlaneBit(position, ChunkPlanes::FirstItem + (int)item.first, item.second > 0);
+    }
+}
+
+uint64_t Grid::getQueryWord(TileQuery query, int chunkX, int y, int minX, int maxX) const
+{
+    ChunkPlanes* planes = _chunks[getChunkSlot(chunkX, y >> Chunk::Shift)].Planes.get();
+
+    // Grass chunks have no planes
+    if (planes == nullptr) return 0;
+
+    uint64_t word = query.Match(*planes, y & (Chunk::Size - 1));
+
+    // Keep the columns of the chunk inside [minX, maxX]
+    int firstBit = std::max(minX - chunkX * Chunk::Size, 0);
+    int lastBit = std::min(maxX - chunkX * Chunk::Size, Chunk::Size - 1);
+
+    word &= ~uint64_t(0) << firstBit;
+    word &= ~uint64_t(0) >> (Chunk::Size - 1 - lastBit);
+
+    return word;
+}
+
+TileQueryRange Grid::QueryTiles(TileQuery query, TilePosition min, TilePosition max) const
+{
+    assert((query.Required != 0 || query.AnyOf != 0) && "A query needs at least one required plane");
+
+    TilePosition worldMin = GetMinTilePosition();
+    TilePosition worldMax = GetMaxTilePosition();
+
+    min = {std::max(min.X, worldMin.X), std::max(min.Y, worldMin.Y)};
+    max = {std::min(max.X, worldMax.X - 1), std::min(max.Y, worldMax.Y - 1)};
+
+    return TileQueryRange(this, query, min, max);
+}
+
+TileQueryRange Grid::QueryTiles(TileQuery query, TilePosition position, int radius) const
+{
+    return QueryTiles(query, position + TilePosition{-radius, -radius}, position + TilePosition{radius, radius});
+}
+
+int Grid::CountTiles(TileQuery query, TilePosition min, TilePosition max) const
+{
+    return QueryTiles(query, min, max).Count();
+}
+
+int Grid::CountTiles(TileQuery query, TilePosition position, int radius) const
+{
+    return CountTiles(query, position + TilePosition{-radius, -radius}, position + TilePosition{radius, radius});
+}
+
+int TileQueryRange::Count() const
+{
+    int count = 0;
+
+    for (int y = _min.Y; y <= _max.Y; y++)
+    {
+        for (int chunkX = _min.X >> Chunk::Shift; chunkX <= _max.X >> Chunk::Shift; chunkX++)
+        {
+            count += std::popcount(getWord(chunkX, y));
+        }
+    }
+
+    return count;
+}
+
+uint64_t TileQueryRange::getWord(int chunkX, int y) const
+{
+    return _grid->getQueryWord(_query, chunkX, y, _min.X, _max.X);
+}
+
+TileQueryRange::Iterator TileQueryRange::begin() const
+{
+    Iterator iterator;
+
+    if (_min.X > _max.X || _min.Y > _max.Y) return iterator;
+
+    iterator._range = this;
+    iterator._y = _min.Y;
+    iterator._chunkX = _min.X >> Chunk::Shift;
+    iterator._word = getWord(iterator._chunkX, iterator._y);
+    iterator._isDone = false;
+    iterator.next();
+
+    return iterator;
+}
+
+void TileQueryRange::Iterator::next()
+{
+    // Move to the next word with a tile in it
+    while (_word == 0)
+    {
+        _chunkX++;
+
+        if (_chunkX > _range->_max.X >> Chunk::Shift)
+        {
+            _chunkX = _range->_min.X >> Chunk::Shift;
+            _y++;
+
+            if (_y > _range->_max.Y)
+            {
+                _isDone = true;
+                return;
+            }
+        }
+
+        _word = _range->getWord(_chunkX, _y);
+    }
+
+    _position = {_chunkX * Chunk::Size + std::countr_zero(_word), _y};
+    _word &= _word - 1;
+}
+
+bool Grid::EnableStreaming(const char* chunkFilePath, int residentChunkBudget)
+{
+    assert(_streamer == nullptr && "Streaming already enabled");
+
+    _streamer = std::make_unique<ChunkStreamer>(chunkFilePath);
+
+    if (!_streamer->IsOpen())
+    {
+        _streamer.reset();
+        return false;
+    }
+
+    _residentChunkBudget = residentChunkBudget;
+
+    return true;
+}
+
+void Grid::PrefetchTile(TilePosition position)
+{
+    int slot = getChunkSlot(position.X >> Chunk::Shift, position.Y >> Chunk::Shift);
+
+    if (slot != -1)
+    {
+        touchChunk(slot);
+    }
+}
+
+void Grid::PrefetchArea(TilePosition min, TilePosition max)
+{
+    int minChunkX = std::max(min.X >> Chunk::Shift, _minChunkX);
+    int minChunkY = std::max(min.Y >> Chunk::Shift, _minChunkY);
+    int maxChunkX = std::min(max.X >> Chunk::Shift, _maxChunkX - 1);
+    int maxChunkY = std::min(max.Y >> Chunk::Shift, _maxChunkY - 1);
+
+    for (int chunkY = minChunkY; chunkY <= maxChunkY; chunkY++)
+    {
+        for (int chunkX = minChunkX; chunkX <= maxChunkX; chunkX++)
+        {
+            touchChunk(getChunkSlot(chunkX, chunkY));
+        }
+    }
+}
+
+bool Grid::isPagedOut(TilePosition position) const
+{
+    int slot = getChunkSlot(position.X >> Chunk::Shift, position.Y >> Chunk::Shift);
+
+    return slot != -1 && _chunks[slot].IsPagedOut;
+}
+
+void Grid::touchChunk(int slot)
+{
+    ChunkSlot &chunkSlot = _chunks[slot];
+
+    chunkSlot.LastUsedFrame = _frame;
+
+    if (chunkSlot.IsPagedOut && !chunkSlot.IsLoading)
+    {
+        chunkSlot.IsLoading = true;
+        _streamer->Read(_minChunkX + slot % (_maxChunkX - _minChunkX), _minChunkY + slot / (_maxChunkX - _minChunkX), chunkSlot.Record);
+    }
+}
+
+void Grid::pageIn(int slot)
+{
+    int chunkX, chunkY;
+    Chunk* chunk;
+
+    // Wait for the chunk if it's already loading, the jobs are done in order
+    _streamer->Flush();
+
+    while (_streamer->PopLoaded(chunkX, chunkY, chunk))
+    {
+        installChunk(chunkX, chunkY, chunk);
+    }
+
+    if (_chunks[slot].IsPagedOut)
+    {
+        installChunk(_minChunkX + slot % (_maxChunkX - _minChunkX), _minChunkY + slot / (_maxChunkX - _minChunkX), _streamer->ReadNow(_chunks[slot].Record));
+    }
+}
+
+void Grid::installChunk(int chunkX, int chunkY, Chunk* chunk)
+{
+    ChunkSlot &slot = _chunks[getChunkSlot(chunkX, chunkY)];
+
+    // Already paged in by a synchronous load
+    if (!slot.IsPagedOut)
+    {
+        delete chunk;
+        return;
+    }
+
+    {
+        std::unique_lock lock(_chunkTableMutex);
+
+        slot.Chunk.reset(chunk);
+        slot.IsPagedOut = false;
+        slot.IsLoading = false;
+    }
+
+    // The events that came due while the chunk was paged out were skipped, the late ones fire at the next tick
+    scheduleChunkEvents(chunkX, chunkY, chunk);
+
+    // It was seen as grass while it was paged out
+    markChunkChanged(getChunkSlot(chunkX, chunkY), TileChange::All);
+}
+
+void Grid::scheduleChunkEvents(int chunkX, int chunkY, Chunk* chunk)
+{
+    for (int i = 0; i < Chunk::TileCount; i++)
+    {
+        scheduleTileEvents(chunk->Tiles[i], {chunkX * Chunk::Size + i % Chunk::Size, chunkY * Chunk::Size + i / Chunk::Size});
+    }
+}
+
+void Grid::KeepDetailed(TilePosition min, TilePosition max, float duration)
+{
+    int64_t detailedUntilTick = GetTick() + (int64_t)(duration * Timer::TicksPerSecond);
+
+    int minChunkX = std::max(min.X >> Chunk::Shift, _minChunkX);
+    int minChunkY = std::max(min.Y >> Chunk::Shift, _minChunkY);
+    int maxChunkX = std::min(max.X >> Chunk::Shift, _maxChunkX - 1);
+    int maxChunkY = std::min(max.Y >> Chunk::Shift, _maxChunkY - 1);
+
+    for (int chunkY = minChunkY; chunkY <= maxChunkY; chunkY++)
+    {
+        for (int chunkX = minChunkX; chunkX <= maxChunkX; chunkX++)
+        {
+            ChunkSlot &slot = _chunks[getChunkSlot(chunkX, chunkY)];
+
+            slot.DetailedUntilTick = std::max(slot.DetailedUntilTick, detailedUntilTick);
+
+            if (slot.IsDetailed) continue;
+
+            slot.IsDetailed = true;
+
+            // Bring the coarse events back to their own tick, the late ones are ignored when they fire
+            if (slot.Chunk != nullptr)
+            {
+                scheduleChunkEvents(chunkX, chunkY, slot.Chunk.get());
+            }
+        }
+    }
+}
+
+bool Grid::IsDetailed(TilePosition position) const
+{
+    int slot = getChunkSlot(position.X >> Chunk::Shift, position.Y >> Chunk::Shift);
 
-    Random::StopUseSeed();
+    return slot != -1 && _chunks[slot].IsDetailed;
 }
 
-void Grid::Update()
+void Grid::demoteChunks()
 {
-    float smoothDeltaTime = Timer::SmoothDeltaTime;
-
-    for (int x = 0; x < _width / _tileSize; x++)
+    // The events already scheduled keep their tick, the next ones are coarse
+    for (auto &slot : _chunks)
     {
-        for (int y = 0; y < _height / _tileSize; y++)
+        if (slot.IsDetailed && slot.DetailedUntilTick < GetTick())
         {
-            Tile &tile = _tiles[x + y * _width];
+            slot.IsDetailed = false;
+        }
+    }
+}
 
-            // Check tree
-            if (tile.Type == TileType::Tree && tile.TreeGrowth < 30.f)
-            {
-                tile.TreeGrowth += smoothDeltaTime;
-            }
+void Grid::pageOutLeastRecentlyUsed()
+{
+    // Keep everything in memory once the chunk file failed, the chunks that failed to be written came back
+    if (_streamer->HasFailed()) return;
 
-            // Check tree spawn, have a 3% chance to spawn a tree on a neighbour tile every 30sec
-            if (tile.Type == TileType::Tree)
-            {
-                tile.TreeSpawnTimer += smoothDeltaTime;
+    std::vector<int> candidates;
+    int residentCount = 0;
 
-                if (tile.TreeSpawnTimer >= 30.f)
-                {
-                    tile.TreeSpawnTimer = 0.f;
+    for (int slot = 0; slot < (int)_chunks.size(); slot++)
+    {
+        if (_chunks[slot].Chunk == nullptr) continue;
 
-                    auto neighbours = GetNeighbours({x, y});
+        residentCount++;
 
-                    for (auto neighbour : neighbours)
-                    {
-                        Tile &tileNeighbour = GetTile(neighbour);
+        // Chunks used during this frame stay in memory even if it's over the budget
+        if (_chunks[slot].LastUsedFrame != _frame)
+        {
+            candidates.push_back(slot);
+        }
+    }
 
-                        if (tileNeighbour.Type == TileType::None && Random::Range(0, 100) < 1)
-                        {
-                            tileNeighbour.Type = TileType::Tree;
-                            tileNeighbour.TreeGrowth = 0.f;
-                            tileNeighbour.TreeSpawnTimer = 0.f;
-                        }
-                    }
-                }
-            }
+    int count = std::min(residentCount - _residentChunkBudget, (int)candidates.size());
 
-            // Check furnace
-            if (tile.Type == TileType::Furnace)
-            {
-                tile.BurnTimer -= smoothDeltaTime;
+    if (count <= 0) return;
 
-                if (tile.BurnTimer <= 0.f)
-                {
-                    tile.BurnTimer = 0.f;
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(), [this](int a, int b)
+    {
+        return _chunks[a].LastUsedFrame < _chunks[b].LastUsedFrame;
+    });
 
-                    if (tile.Inventory->at(Items::Coal) > 0 && tile.Inventory->at(Items::IronOre) > 3)
-                    {
-                        tile.Inventory->at(Items::Coal)--;
-                        tile.BurnTimer = 30.f;
-                    }
-                }
+    // The pathfinding threads must not read the chunks while they are given to the streamer
+    std::unique_lock lock(_chunkTableMutex);
 
-                if (tile.BurnTimer > 0.f)
-                {
-                    // Can melt some things
-                    if (tile.SmeltTimer == 0.f)
-                    {
-                        // Check if he has enough items to smelt
-                        if (tile.Inventory->at(Items::IronOre) > 3 && tile.Inventory->at(Items::IronIngot) < GetMaxItemsStored(tile, Items::IronIngot))
-                        {
-                            tile.Inventory->at(Items::IronOre) -= 3;
-                            tile.SmeltTimer = 10.f;
-                        }
-                    }
-                    else
-                    {
-                        tile.SmeltTimer -= smoothDeltaTime;
+    for (int i = 0; i < count; i++)
+    {
+        ChunkSlot &slot = _chunks[candidates[i]];
 
-                        if (tile.SmeltTimer <= 0.f)
-                        {
-                            tile.SmeltTimer = 0.f;
-                            tile.Inventory->at(Items::IronIngot)++;
-                        }
-                    }
-                }
-            }
+        if (slot.Record == -1)
+        {
+            slot.Record = _streamer->AllocateRecord();
+        }
 
-            // Check construction
-            if (!tile.IsBuilt && tile.Type != TileType::None)
-            {
-                tile.IsBuilt = GetMaxConstructionProgress(tile.Type) <= tile.Progress;
-            }
+        _streamer->Write(_minChunkX + candidates[i] % (_maxChunkX - _minChunkX), _minChunkY + candidates[i] / (_maxChunkX - _minChunkX), slot.Chunk.release(), slot.Record);
 
-            // Check destruction
-            if (tile.IsBuilt && tile.Type != TileType::None && tile.NeedToBeDestroyed)
-            {
-                if (GetMaxDestructionProgress(tile.Type) <= tile.Progress)
-                {
-                    tile.Type = TileType::None;
-                    tile.IsBuilt = false;
-                    tile.NeedToBeDestroyed = false;
-                    tile.Progress = 0.f;
-                }
-            }
-        }
+        slot.IsPagedOut = true;
+
+        markChunkChanged(candidates[i], TileChange::All);
     }
 }
 
 TilePosition Grid::GetTilePosition(Vector2F position) const
 {
     return TilePosition{
-        (int)(position.X + _width / 2.f) / _tileSize,
-        (int)(position.Y + _height / 2.f) / _tileSize};
+        (int)std::floor(position.X / (float)_tileSize),
+        (int)std::floor(position.Y / (float)_tileSize)};
 }
 
 [[nodiscard]] TilePosition Grid::GetTilePosition(int tileIndex) const
 {
     return TilePosition{
-        tileIndex % _width,
-        tileIndex / _width};
+        tileIndex % MaxWorldSize - MaxWorldSize / 2,
+        tileIndex / MaxWorldSize - MaxWorldSize / 2};
 }
 
 Vector2F Grid::ToWorldPosition(TilePosition position) const
 {
     return Vector2F{
-        (float)position.X * _tileSize - _width / 2.f,
-        (float)position.Y * _tileSize - _height / 2.f};
+        (float)position.X * _tileSize,
+        (float)position.Y * _tileSize};
 }
 
 Tile &Grid::GetTile(TilePosition position)
 {
-    return _tiles[position.X + position.Y * _width];
+    Chunk* chunk = getOrCreateChunk(position);
+
+    return chunk->Tiles[(position.X & (Chunk::Size - 1)) + (position.Y & (Chunk::Size - 1)) * Chunk::Size];
 }
 
 Tile &Grid::GetTile(int index)
 {
-    return _tiles[index];
+    return GetTile(GetTilePosition(index));
+}
+
+const Tile &Grid::PeekTile(TilePosition position) const
+{
+    Chunk* chunk = getChunk(position);
+
+    if (chunk == nullptr)
+    {
+        return _emptyTile;
+    }
+
+    return chunk->Tiles[(position.X & (Chunk::Size - 1)) + (position.Y & (Chunk::Size - 1)) * Chunk::Size];
 }
 
 int Grid::GetTileIndex(TilePosition position) const
 {
-    return position.X + position.Y * _width;
+    return (position.X + MaxWorldSize / 2) + (position.Y + MaxWorldSize / 2) * MaxWorldSize;
 }
 
 bool Grid::IsTileValid(TilePosition position) const
 {
-    return position.X >= 0 && position.X < _width / _tileSize && position.Y >= 0 && position.Y < _height / _tileSize;
+    return getChunkSlot(position.X >> Chunk::Shift, position.Y >> Chunk::Shift) != -1;
 }
 
 void Grid::SetTile(TilePosition position, Tile tile)
 {
     // Set the tile as build if it's not a building
-    if (tile.Type == TileType::None || tile.Type == TileType::Tree || tile.Type == TileType::Road || tile.Type == TileType::Stone)
+    if (isAlwaysBuilt(tile.Type))
     {
         tile.IsBuilt = true;
     }
 
-    _tiles[position.X + position.Y * _width] = tile;
+    startTile(tile, GetTick());
+    replaceTile(GetTile(position), position, tile);
+}
+
+void Grid::replaceTile(Tile &current, TilePosition position, const Tile &tile)
+{
+    untrackTile(current, position);
+    current = tile;
+    trackTile(current, position);
+    scheduleTileEvents(current, position);
+    markChanged(position, TileChange::All);
 }
 
 void Grid::RemoveTile(TilePosition position)
 {
-    _tiles[position.X + position.Y * _width] = Tile(TileType::None);
+    SetTile(position, Tile(TileType::None));
 }
 
-std::vector<TilePosition> Grid::GetTiles(TileType type) const
+void Grid::ResetTile(TilePosition position)
 {
-    std::vector<TilePosition> tiles;
+    Tile &tile = GetTile(position);
 
-    for (int x = 0; x < _width / _tileSize; x++)
-    {
-        for (int y = 0; y < _height / _tileSize; y++)
-        {
-            Tile &tile = _tiles[x + y * _width];
+    untrackTile(tile, position);
+    tile.Reset();
+    markChanged(position, TileChange::All);
+}
 
-            if (tile.Type == type && tile.IsBuilt)
-            {
-                tiles.push_back(TilePosition{x, y});
-            }
-        }
+void Grid::SetTileType(TilePosition position, TileType type)
+{
+    Tile &tile = GetTile(position);
+
+    untrackTile(tile, position);
+
+    if (tile.Type != type)
+    {
+        tile.Type = type;
+        startTile(tile, GetTick());
     }
 
-    return tiles;
+    tile.IsBuilt = true;
+    tile.NeedToBeDestroyed = false;
+    tile.Progress = 0.f;
+
+    trackTile(tile, position);
+    scheduleTileEvents(tile, position);
+    markChanged(position, TileChange::Type | TileChange::Built | TileChange::Destruction | TileChange::Progress | TileChange::TreeGrowth | TileChange::Furnace);
 }
 
-std::vector<TilePosition> Grid::GetTiles(TileType type, TilePosition position, int radius) const
+void Grid::FinishConstruction(TilePosition position)
 {
-    std::vector<TilePosition> tiles;
+    Tile &tile = GetTile(position);
 
-    for (int x = position.X - radius; x <= position.X + radius; x++)
-    {
-        for (int y = position.Y - radius; y <= position.Y + radius; y++)
-        {
-            Tile &tile = _tiles[x + y * _width];
+    untrackTile(tile, position);
 
-            if (tile.Type == type && tile.IsBuilt)
-            {
-                tiles.push_back(TilePosition{x, y});
-            }
-        }
-    }
+    tile.IsBuilt = true;
+    tile.NeedToBeDestroyed = false;
+    tile.Progress = 0.f;
 
-    return tiles;
+    trackTile(tile, position);
+    scheduleTileEvents(tile, position);
+    markChanged(position, TileChange::Built | TileChange::Destruction | TileChange::Progress);
 }
 
-std::vector<TilePosition> Grid::GetTiles(TilePosition position, int radius) const
+void Grid::SetNeedToBeDestroyed(TilePosition position, bool needToBeDestroyed)
 {
-    std::vector<TilePosition> tiles;
+    Tile &tile = GetTile(position);
 
-    for (int x = position.X - radius; x <= position.X + radius; x++)
-    {
-        for (int y = position.Y - radius; y <= position.Y + radius; y++)
-        {
-            Tile &tile = _tiles[x + y * _width];
+    untrackTile(tile, position);
 
-            if (tile.Type != TileType::None && tile.IsBuilt)
-            {
-                tiles.push_back(TilePosition{x, y});
-            }
-        }
+    tile.NeedToBeDestroyed = needToBeDestroyed;
+    tile.Progress = 0.f;
+
+    trackTile(tile, position);
+    markChanged(position, TileChange::Destruction | TileChange::Progress);
+}
+
+void Grid::SetTreeGrowth(TilePosition position, float treeGrowth)
+{
+    Tile &tile = GetTile(position);
+
+    untrackTile(tile, position);
+    tile.TreePlantedTick = GetTick() - (int64_t)(treeGrowth * Timer::TicksPerSecond);
+    trackTile(tile, position);
+
+    if (treeGrowth < 30.f)
+    {
+        scheduleEvent(tile.TreePlantedTick + treeMatureTicks, position, TileEvent::TreeMatures);
     }
 
-    return tiles;
+    markChanged(position, TileChange::TreeGrowth);
+}
+
+void Grid::AddItems(TilePosition position, Items item, int count)
+{
+    if (count == 0) return;
+
+    Tile &tile = GetTile(position);
+
+    tile.Inventory.at(item) += count;
+    setItemBits(tile, position);
+    markChanged(position, TileChange::Inventory);
+}
+
+void Grid::AddProgress(TilePosition position, float progress)
+{
+    GetTile(position).Progress += progress;
+    markChanged(position, TileChange::Progress);
+}
+
+std::span<const TilePosition> Grid::GetTiles(TileType type) const
+{
+    return _builtTiles[(int)type];
 }
 
 std::vector<TilePosition> Grid::GetTilesWithItems(TileType type, Items item) const
 {
     std::vector<TilePosition> tiles;
 
-    for (int x = 0; x < _width / _tileSize; x++)
+    // The item planes are kept for the paged out chunks, so nothing is loaded
+    for (auto position : _builtTiles[(int)type])
     {
-        for (int y = 0; y < _height / _tileSize; y++)
-        {
-            Tile &tile = _tiles[x + y * _width];
+        const ChunkPlanes* planes = _chunks[getChunkSlot(position.X >> Chunk::Shift, position.Y >> Chunk::Shift)].Planes.get();
 
-            if (tile.Type == type && tile.IsBuilt && tile.Inventory->at(item) > 0)
-            {
-                tiles.push_back(TilePosition{x, y});
-            }
+        if ((planes->Rows[ChunkPlanes::FirstItem + (int)item][position.Y & (Chunk::Size - 1)] >> (position.X & (Chunk::Size - 1))) & 1)
+        {
+            tiles.push_back(position);
         }
     }
 
     return tiles;
 }
 
-void Grid::ForEachTile(const std::function<void(Tile &, TilePosition)> &callback) const
+float Grid::GetMaxConstructionProgress(TileType type)
+{
+    return GetTileDefinition(type).ConstructionTime;
+}
+
+float Grid::GetMaxDestructionProgress(TileType type)
+{
+    return GetTileDefinition(type).DestructionTime;
+}
+
+float Grid::GetSpeedFactor(TileType type)
+{
+    return GetTileDefinition(type).WorkerSpeedFactor;
+}
+
+bool Grid::CanBuild(TilePosition position, TileType type)
+{
+    return isBuildable(position, type);
+}
+
+uint64_t Grid::getBuildableWord(TileType type, int chunkX, int y) const
 {
-    for (int x = 0; x < _width / _tileSize; x++)
+    // The planes are kept for the paged out chunks, only the grass chunks have none
+    ChunkPlanes* planes = _chunks[getChunkSlot(chunkX, y >> Chunk::Shift)].Planes.get();
+    int row = y & (Chunk::Size - 1);
+
+    // Quarries are built on stones, the rest on grass
+    if (type == TileType::Quarry)
     {
-        for (int y = 0; y < _height / _tileSize; y++)
-        {
-            Tile &tile = _tiles[x + y * _width];
-            callback(tile, TilePosition{x, y});
-        }
+        return planes == nullptr ? 0 : TileQuery{TileQuery::Plane(TileType::Stone)}.Match(*planes, row);
     }
+
+    return planes == nullptr ? ~uint64_t(0) : ~TileQuery::Any().Match(*planes, row);
 }
 
-float Grid::GetMaxConstructionProgress(TileType type)
+bool Grid::isBuildable(TilePosition position, TileType type) const
+{
+    if (!IsTileValid(position)) return false;
+
+    return (getBuildableWord(type, position.X >> Chunk::Shift, position.Y) >> (position.X & (Chunk::Size - 1))) & 1;
+}
+
+int Grid::applyEdits(const std::vector<TileEdit> &edits, int invalidCount, bool isBuilt, bool isPartial)
 {
-    switch (type)
+    if (invalidCount > 0 && !isPartial) return 0;
+
+    // Group the edits by chunk so each chunk is looked up and paged in once
+    std::vector<std::pair<int, int>> order(edits.size());
+
+    for (int i = 0; i < (int)edits.size(); i++)
     {
-        case TileType::Sawmill:
-            return 10.f;
-        case TileType::Quarry:
-            return 15.f;
-        case TileType::BuilderHut:
-            return 10.f;
-        case TileType::Storage:
-            return 10.f;
-        case TileType::House:
-            return 30.f;
-        case TileType::LogisticsCenter:
-            return 10.f;
-        case TileType::Furnace:
-            return 15.f;
+        order[i] = {getChunkSlot(edits[i].Position.X >> Chunk::Shift, edits[i].Position.Y >> Chunk::Shift), i};
     }
 
-    return 0.f;
+    std::sort(order.begin(), order.end());
+
+    int64_t tick = GetTick();
+    Chunk* chunk = nullptr;
+    int chunkSlot = -1;
+
+    for (auto [slot, index] : order)
+    {
+        TilePosition position = edits[index].Position;
+
+        if (slot != chunkSlot)
+        {
+            chunk = getOrCreateChunk(position);
+            chunkSlot = slot;
+        }
+
+        Tile tile = Tile(edits[index].Type);
+        tile.IsBuilt = isBuilt || isAlwaysBuilt(tile.Type);
+
+        startTile(tile, tick);
+        replaceTile(chunk->Tiles[(position.X & (Chunk::Size - 1)) + (position.Y & (Chunk::Size - 1)) * Chunk::Size], position, tile);
+    }
+
+    return (int)edits.size();
 }
 
-float Grid::GetMaxDestructionProgress(TileType type)
+int Grid::FillArea(TilePosition min, TilePosition max, TileType type, bool isBuilt, bool isPartial)
 {
-    switch (type)
+    TilePosition worldMin = GetMinTilePosition();
+    TilePosition worldMax = GetMaxTilePosition();
+
+    // The tiles outside of the world can't be built
+    if (!isPartial && (min.X < worldMin.X || min.Y < worldMin.Y || max.X >= worldMax.X || max.Y >= worldMax.Y)) return 0;
+
+    min = {std::max(min.X, worldMin.X), std::max(min.Y, worldMin.Y)};
+    max = {std::min(max.X, worldMax.X - 1), std::min(max.Y, worldMax.Y - 1)};
+
+    std::vector<TileEdit> edits;
+    int invalidCount = 0;
+
+    for (int y = min.Y; y <= max.Y; y++)
     {
-        case TileType::Sawmill:
-            return 5.f;
-        case TileType::Quarry:
-            return 7.5f;
-        case TileType::BuilderHut:
-            return 5.f;
-        case TileType::Storage:
-            return 5.f;
-        case TileType::House:
-            return 15.f;
-        case TileType::Tree:
-            return 5.f;
-        case TileType::Stone:
-            return 10.f;
-        case TileType::LogisticsCenter:
-            return 5.f;
-        case TileType::Furnace:
-            return 7.5f;
+        for (int chunkX = min.X >> Chunk::Shift; chunkX <= max.X >> Chunk::Shift; chunkX++)
+        {
+            int firstBit = std::max(min.X - chunkX * Chunk::Size, 0);
+            int lastBit = std::min(max.X - chunkX * Chunk::Size, Chunk::Size - 1);
+            uint64_t columns = (~uint64_t(0) << firstBit) & (~uint64_t(0) >> (Chunk::Size - 1 - lastBit));
+            uint64_t buildable = getBuildableWord(type, chunkX, y) & columns;
+
+            invalidCount += std::popcount(columns & ~buildable);
+
+            for (; buildable != 0; buildable &= buildable - 1)
+            {
+                edits.push_back({{chunkX * Chunk::Size + std::countr_zero(buildable), y}, type});
+            }
+        }
     }
 
-    return 0.f;
+    return applyEdits(edits, invalidCount, isBuilt, isPartial);
 }
 
-float Grid::GetSpeedFactor(TileType type)
+int Grid::PaintLine(TilePosition from, TilePosition to, TileType type, bool isBuilt, bool isPartial)
 {
-    switch (type)
+    std::vector<TileEdit> edits;
+    int invalidCount = 0;
+
+    int dx = std::abs(to.X - from.X);
+    int dy = -std::abs(to.Y - from.Y);
+    int stepX = from.X < to.X ? 1 : -1;
+    int stepY = from.Y < to.Y ? 1 : -1;
+    int error = dx + dy;
+    TilePosition position = from;
+
+    while (true)
     {
-    case TileType::Quarry:
-        return -0.5f;
-    case TileType::BuilderHut:
-        return 0.25f;
-    case TileType::LogisticsCenter:
-        return 0.5f;
+        if (isBuildable(position, type))
+        {
+            edits.push_back({position, type});
+        }
+        else
+        {
+            invalidCount++;
+        }
+
+        if (position == to) break;
+
+        // Bresenham with a single axis per step
+        if (2 * error - dy > dx - 2 * error)
+        {
+            error += dy;
+            position.X += stepX;
+        }
+        else
+        {
+            error += dx;
+            position.Y += stepY;
+        }
     }
 
-    return 0.f;
+    return applyEdits(edits, invalidCount, isBuilt, isPartial);
 }
 
-bool Grid::CanBuild(TilePosition position, TileType type)
+int Grid::StampPrefab(const Prefab &prefab, TilePosition origin, bool isBuilt, bool isPartial)
 {
-    Tile &tile = GetTile(position);
+    std::vector<TileEdit> edits;
+    int invalidCount = 0;
 
-    if (type == TileType::Quarry)
+    for (int y = 0; y < prefab.Height; y++)
     {
-        return tile.Type == TileType::Stone;
+        for (int x = 0; x < prefab.Width; x++)
+        {
+            TileType type = prefab.GetType(x, y);
+            TilePosition position = origin + TilePosition{x, y};
+
+            if (type == TileType::None) continue;
+
+            if (isBuildable(position, type))
+            {
+                edits.push_back({position, type});
+            }
+            else
+            {
+                invalidCount++;
+            }
+        }
     }
 
-    if (tile.Type == TileType::None)
+    return applyEdits(edits, invalidCount, isBuilt, isPartial);
+}
+
+int Grid::ClearArea(TilePosition min, TilePosition max, bool isPartial)
+{
+    std::vector<TileEdit> edits;
+    int invalidCount = 0;
+
+    // CanBeDestroyed keeps the last logistics center and builder hut, the area can hold all of them
+    int logisticsCenterCount = (int)GetTiles(TileType::LogisticsCenter).size();
+    int builderHutCount = (int)GetTiles(TileType::BuilderHut).size();
+
+    for (auto position : QueryTiles(TileQuery::Any(), min, max))
     {
-        return true;
+        // The check reads the tile, its chunk may be paged out
+        getOrCreateChunk(position);
+
+        TileType type = PeekTile(position).Type;
+        bool isLast = (type == TileType::LogisticsCenter && logisticsCenterCount == 1) || (type == TileType::BuilderHut && builderHutCount == 1);
+
+        if (isLast || !CanBeDestroyed(position))
+        {
+            invalidCount++;
+            continue;
+        }
+
+        if (type == TileType::LogisticsCenter) logisticsCenterCount--;
+        if (type == TileType::BuilderHut) builderHutCount--;
+
+        edits.push_back({position, TileType::None});
     }
 
-    return false;
+    return applyEdits(edits, invalidCount, true, isPartial);
 }
 
 bool Grid::CanBeDestroyed(TilePosition position)
 {
-    Tile &tile = GetTile(position);
+    const Tile &tile = PeekTile(position);
 
     if (tile.Type == TileType::None) return false;
     if (tile.Type == TileType::LogisticsCenter && GetTiles(TileType::LogisticsCenter).size() == 1) return false;
@@ -606,30 +2079,24 @@ bool Grid::CanBeDestroyed(TilePosition position)
 
 int Grid::GetMaxItemsStored(const Tile &tile, Items item)
 {
-    if (!tile.IsBuilt || !tileMaxInventory->contains(tile.Type) || !tileMaxInventory->at(tile.Type).contains(item))
-    {
-        return 0;
-    }
+    if (!tile.IsBuilt) return 0;
 
-    return tileMaxInventory->at(tile.Type)[item];
+    return GetTileDefinition(tile.Type).MaxItemsStored[(int)item];
 }
 
 int Grid::GetLeftSpaceForItems(Tile tile, Items item)
 {
     int max = GetMaxItemsStored(tile, item);
 
-    return max - tile.Inventory->at(item);
+    return max - tile.Inventory.at(item);
 }
 
 bool Grid::IsTileReadyToBuild(Tile &tile)
 {
     // Check if the tile has the items to be built
-    if (!tileNeededItems.contains(tile.Type)) return true;
-    if (tileNeededItems[tile.Type].empty()) return true;
-
-    for (auto &item : tileNeededItems[tile.Type])
+    for (auto &item : tile.Inventory)
     {
-        if (tile.Inventory->at(item.first) < item.second)
+        if (item.second < GetNeededItemsToBuild(tile.Type, item.first))
         {
             return false;
         }
@@ -640,21 +2107,19 @@ bool Grid::IsTileReadyToBuild(Tile &tile)
 
 bool Grid::IsAStorage(TileType type)
 {
-    return type == TileType::Storage || type == TileType::LogisticsCenter || type == TileType::MayorHouse;
+    return GetTileDefinition(type).IsStorage;
 }
 
 int Grid::GetNeededItemsToBuild(TileType type, Items item)
 {
-    if (!tileNeededItems.contains(type) || !tileNeededItems[type].contains(item))
-    {
-        return 0;
-    }
-
-    return tileNeededItems[type][item];
+    return GetTileDefinition(type).NeededItemsToBuild[(int)item];
 }
 
-std::vector<TilePosition> Grid::GetPath(TilePosition start, TilePosition end)
+std::vector<TilePosition> Grid::GetPath(TilePosition start, TilePosition end) const
 {
+    // Called from other threads, keep the chunk table alive while searching
+    std::shared_lock lock(_chunkTableMutex);
+
     // Points per tile, the higher the value, the less the path will use this tile
     std::vector<int> pointsPerTile = std::vector<int>();
 
@@ -674,24 +2139,14 @@ std::vector<TilePosition> Grid::GetPath(TilePosition start, TilePosition end)
 
     openList.push_back(start);
 
-    // Use tile index
-    auto cameFrom = std::vector<TilePosition>();
+    // Use tile index, only the visited tiles are stored to not depend on the world size
+    auto cameFrom = std::unordered_map<int, TilePosition>();
 
-    auto gScore = std::vector<int>();
-    auto fScore = std::vector<int>();
+    auto gScore = std::unordered_map<int, int>();
+    auto fScore = std::unordered_map<int, int>();
 
-    for (int x = 0; x < _width / _tileSize; x++)
-    {
-        for (int y = 0; y < _height / _tileSize; y++)
-        {
-            cameFrom.push_back(TilePosition{-1, -1});
-            gScore.push_back(0);
-            fScore.push_back(0);
-        }
-    }
-
-    gScore[start.X + start.Y * _width / _tileSize] = 0;
-    fScore[start.X + start.Y * _width / _tileSize] = start.X - end.X + start.Y - end.Y;
+    gScore[GetTileIndex(start)] = 0;
+    fScore[GetTileIndex(start)] = start.X - end.X + start.Y - end.Y;
 
     while (!openList.empty())
     {
@@ -701,7 +2156,7 @@ std::vector<TilePosition> Grid::GetPath(TilePosition start, TilePosition end)
 
         for (size_t i = 0; i < openList.size(); i++)
         {
-            int index = openList[i].X + openList[i].Y * _width / _tileSize;
+            int index = GetTileIndex(openList[i]);
 
             if (fScore[index] < lowestScore)
             {
@@ -720,7 +2175,7 @@ std::vector<TilePosition> Grid::GetPath(TilePosition start, TilePosition end)
             while (tmpCurrent != start)
             {
                 path.push_back(tmpCurrent);
-                tmpCurrent = cameFrom[tmpCurrent.X + tmpCurrent.Y * _width / _tileSize];
+                tmpCurrent = cameFrom[GetTileIndex(tmpCurrent)];
             }
 
             std::reverse(path.begin(), path.end());
@@ -731,73 +2186,147 @@ std::vector<TilePosition> Grid::GetPath(TilePosition start, TilePosition end)
         openList.erase(openList.begin() + lowestScoreIndex);
         closedList.push_back(current);
 
-        for (auto &neighbour : GetNeighbours(current))
+        ForEachNeighbour(current, [&](TilePosition neighbour)
         {
             if (std::find(closedList.begin(), closedList.end(), neighbour) != closedList.end())
             {
-                continue;
+                return;
             }
 
+            int neighbourIndex = GetTileIndex(neighbour);
+
             // The distance from start to a neighbor through current, the "distance between two adjacent tiles" is always 1
-            int tentativeGScore = gScore[current.X + current.Y * _width / _tileSize] + pointsPerTile[(int)GetTile(neighbour).Type];
+            int tentativeGScore = gScore[GetTileIndex(current)] + pointsPerTile[(int)PeekTile(neighbour).Type];
 
             if (std::find(openList.begin(), openList.end(), neighbour) == openList.end())
             {
                 openList.push_back(neighbour);
             }
-            else if (tentativeGScore >= gScore[neighbour.X + neighbour.Y * _width / _tileSize])
+            else if (tentativeGScore >= gScore[neighbourIndex])
             {
-                continue;
+                return;
             }
 
-            cameFrom[neighbour.X + neighbour.Y * _width / _tileSize] = current;
-            gScore[neighbour.X + neighbour.Y * _width / _tileSize] = tentativeGScore;
-            fScore[neighbour.X + neighbour.Y * _width / _tileSize] = gScore[neighbour.X + neighbour.Y * _width / _tileSize] + neighbour.X - end.X + neighbour.Y - end.Y;
-        }
+            cameFrom[neighbourIndex] = current;
+            gScore[neighbourIndex] = tentativeGScore;
+            fScore[neighbourIndex] = gScore[neighbourIndex] + neighbour.X - end.X + neighbour.Y - end.Y;
+        });
     }
 
     return path;
 }
 
-std::vector<TilePosition> Grid::GetNeighbours(TilePosition position) const
+void Serialize(Serializer* ser, Grid* grid)
 {
-    std::vector<TilePosition> neighbours = std::vector<TilePosition>();
-
-    if (position.X > 0)
+    if (ser->DataVersion < SV_ChunkedGrid)
     {
-        neighbours.push_back(TilePosition{position.X - 1, position.Y});
+        // Flat grid in pixels centered on the world origin, stored column by column
+        int width, height, tileSize;
+
+        Serialize(ser, &width);
+        Serialize(ser, &height);
+        Serialize(ser, &tileSize);
+
+        int tilesWidth = width / tileSize;
+        int tilesHeight = height / tileSize;
+
+        ser->LegacyTileOffsetX = tilesWidth / 2;
+        ser->LegacyTileOffsetY = tilesHeight / 2;
+
+        std::unique_lock lock(grid->_chunkTableMutex);
+
+        // The old saves have their tree timers converted for the tick 0
+        grid->Reset(tilesWidth, tilesHeight, tileSize);
+
+        for (int x = 0; x < tilesWidth; x++)
+        {
+            for (int y = 0; y < tilesHeight; y++)
+            {
+                Serialize(ser, &grid->GetTile({x - ser->LegacyTileOffsetX, y - ser->LegacyTileOffsetY}));
+            }
+        }
+
+        grid->rebuildTracking();
+
+        return;
     }
 
-    if (position.X < _width / _tileSize - 1)
+    Serialize(ser, &grid->_tileSize);
+    Serialize(ser, &grid->_minChunkX);
+    Serialize(ser, &grid->_minChunkY);
+    Serialize(ser, &grid->_maxChunkX);
+    Serialize(ser, &grid->_maxChunkY);
+
+    int64_t tick = ser->IsWriting ? grid->GetTick() : 0;
+
+    if (ser->DataVersion >= SV_TickedTiles)
     {
-        neighbours.push_back(TilePosition{position.X + 1, position.Y});
+        Serialize(ser, &tick);
     }
 
-    if (position.Y > 0)
+    // The older saves keep the seed of the current map
+    if (ser->DataVersion >= SV_GridSeed)
     {
-        neighbours.push_back(TilePosition{position.X, position.Y - 1});
+        Serialize(ser, (int64_t*)&grid->_seed);
     }
 
-    if (position.Y < _height / _tileSize - 1)
+    std::unique_lock lock(grid->_chunkTableMutex, std::defer_lock);
+
+    if (!ser->IsWriting)
     {
-        neighbours.push_back(TilePosition{position.X, position.Y + 1});
+        lock.lock();
+        grid->releaseChunks();
+        grid->_chunks = std::vector<ChunkSlot>((grid->_maxChunkX - grid->_minChunkX) * (grid->_maxChunkY - grid->_minChunkY));
     }
+    else if (grid->_streamer != nullptr)
+    {
+        int chunkX, chunkY;
+        Chunk* chunk;
 
-    return neighbours;
-}
+        // The paged out chunks are read from the chunk file, the loaded ones and the ones that failed to be written are installed first
+        grid->_streamer->Flush();
 
-void Serialize(Serializer* ser, Grid* grid)
-{
-    Serialize(ser, &grid->_width);
-    Serialize(ser, &grid->_height);
-    Serialize(ser, &grid->_tileSize);
+        while (grid->_streamer->PopLoaded(chunkX, chunkY, chunk))
+        {
+            grid->installChunk(chunkX, chunkY, chunk);
+        }
+    }
 
-    for (int x = 0; x < grid->_width / grid->_tileSize; x++)
+    for (auto& slot : grid->_chunks)
     {
-        for (int y = 0; y < grid->_height / grid->_tileSize; y++)
+        bool isAllocated = slot.Chunk != nullptr || slot.IsPagedOut;
+
+        Serialize(ser, &isAllocated);
+
+        if (!isAllocated) continue;
+
+        Chunk* chunk = slot.Chunk.get();
+
+        if (slot.IsPagedOut)
+        {
+            chunk = grid->_streamer->ReadNow(slot.Record);
+        }
+        else if (chunk == nullptr)
+        {
+            slot.Chunk = std::make_unique<Chunk>();
+            slot.Planes = std::make_unique<ChunkPlanes>();
+            chunk = slot.Chunk.get();
+        }
+
+        for (auto& tile : chunk->Tiles)
+        {
+            Serialize(ser, &tile);
+        }
+
+        if (slot.IsPagedOut)
         {
-            //printf("current Tile : %i, %i \n", x, y); //Debug current Tile
-            Serialize(ser, &grid->_tiles[x + y * grid->_width]);
+            delete chunk;
         }
     }
+
+    if (!ser->IsWriting)
+    {
+        grid->_events->Reset(tick);
+        grid->rebuildTracking();
+    }
 }
@@ -0,0 +1,136 @@
+#include "MapGenerator.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+#include "Random.h"
+
+// Keys of the noise layers, so the forests and the rock fields don't line up
+constexpr uint64_t forestNoiseKey = 1;
+constexpr uint64_t rockNoiseKey = 2;
+
+// The 8 directions of the lattice gradients, in a table rather than a switch so the random picks don't cost branch misses
+constexpr float gradientX[8] = {1.f, 1.f, -1.f, -1.f, 1.f, -1.f, 0.f, 0.f};
+constexpr float gradientY[8] = {1.f, -1.f, 1.f, -1.f, 0.f, 0.f, 1.f, -1.f};
+
+// Gradient of a lattice point, picked by a hash of the point
+static int latticeGradient(int x, int y, uint64_t seed)
+{
+    uint64_t hash = seed ^ ((uint64_t)(uint32_t)x * 0x9E3779B97F4A7C15ULL) ^ ((uint64_t)(uint32_t)y * 0xC2B2AE3D27D4EB4FULL);
+    hash = (hash ^ (hash >> 29)) * 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 32;
+
+    return (int)(hash & 7);
+}
+
+static float dotGradient(int gradient, float dx, float dy)
+{
+    return gradientX[gradient] * dx + gradientY[gradient] * dy;
+}
+
+static float interpolate(float a, float b, float t)
+{
+    return a + (b - a) * t;
+}
+
+// Quintic curve, the noise has no visible seams at the lattice lines
+static float fade(float t)
+{
+    return t * t * t * (t * (t * 6.f - 15.f) + 10.f);
+}
+
+MapGenerator::MapGenerator(uint64_t seed)
+{
+    _seed = seed;
+}
+
+void MapGenerator::GetRowTiles(int chunkX, int tileY, TileType* types, float* treeGrowths) const
+{
+    int firstX = chunkX * Chunk::Size;
+    float rocks[Chunk::Size];
+    float forests[Chunk::Size];
+
+    fractalNoiseRow(firstX, tileY, RockScale, _seed + rockNoiseKey, 3, rocks);
+    fractalNoiseRow(firstX, tileY, ForestScale, _seed + forestNoiseKey, 4, forests);
+
+    // A stream per row of a chunk, its tiles draw from it from left to right
+    RandomStream random = RandomStream(_seed).Split(((uint64_t)(uint32_t)chunkX << 32) | (uint32_t)tileY);
+
+    for (int i = 0; i < Chunk::Size; i++)
+    {
+        types[i] = TileType::None;
+        treeGrowths[i] = 0.f;
+
+        float distance = TilePosition{firstX + i, tileY}.GetDistance(ClearingCenter);
+        float clearing = std::clamp((distance - ClearingRadius) / ClearingRadius, 0.f, 1.f);
+
+        if (clearing == 0.f) continue;
+
+        if (rocks[i] > RockThreshold && random.Range(0.f, 1.f) < RockDensity * clearing)
+        {
+            types[i] = TileType::Stone;
+            continue;
+        }
+
+        float density = std::clamp((forests[i] - ForestThreshold) / ForestEdge, 0.f, 1.f) * ForestDensity;
+
+        if (random.Range(0.f, 1.f) >= std::max(density, ScatteredTreeDensity) * clearing) continue;
+
+        types[i] = TileType::Tree;
+        treeGrowths[i] = random.Range(0.f, 30.f);
+    }
+}
+
+void MapGenerator::fractalNoiseRow(int firstX, int y, float scale, uint64_t seed, int octaves, float* values) const
+{
+    float amplitude = 1.f;
+    float amplitudeSum = 0.f;
+
+    std::fill(values, values + Chunk::Size, 0.f);
+
+    for (int octave = 0; octave < octaves; octave++)
+    {
+        float frequency = (float)(1 << octave) / scale;
+        uint64_t octaveSeed = seed + octave * 0x100;
+
+        float rowY = (float)y * frequency;
+        float floorY = std::floor(rowY);
+        auto cellY = (int)floorY;
+        float dy = rowY - floorY;
+        float fadeY = fade(dy);
+
+        // The tiles of a lattice cell share the gradients of its corners, so the inner loop has no branch or hash
+        for (int first = 0; first < Chunk::Size;)
+        {
+            auto cellX = (int)std::floor((float)(firstX + first) * frequency);
+            // The first tile of the next cell, a tile rounded to the wrong side gets the same value from either cell
+            int last = std::clamp((int)std::ceil((float)(cellX + 1) / frequency) - firstX, first + 1, Chunk::Size);
+
+            int topLeft = latticeGradient(cellX, cellY, octaveSeed);
+            int topRight = latticeGradient(cellX + 1, cellY, octaveSeed);
+            int bottomLeft = latticeGradient(cellX, cellY + 1, octaveSeed);
+            int bottomRight = latticeGradient(cellX + 1, cellY + 1, octaveSeed);
+
+            for (int i = first; i < last; i++)
+            {
+                float dx = (float)(firstX + i) * frequency - (float)cellX;
+                float fadeX = fade(dx);
+                float top = interpolate(dotGradient(topLeft, dx, dy), dotGradient(topRight, dx - 1.f, dy), fadeX);
+                float bottom = interpolate(dotGradient(bottomLeft, dx, dy - 1.f), dotGradient(bottomRight, dx - 1.f, dy - 1.f), fadeX);
+
+                values[i] += interpolate(top, bottom, fadeY) * amplitude;
+            }
+
+            first = last;
+        }
+
+        amplitudeSum += amplitude;
+        amplitude *= 0.5f;
+    }
+
+    for (int i = 0; i < Chunk::Size; i++)
+    {
+        values[i] /= amplitudeSum;
+    }
+}
@@ -2,56 +2,62 @@
 
 #include <random>
 
-int seed = 0;
-int offset = 0;
-bool useSeed = false;
+// SplitMix64 finalizer, spreads close keys and seeds over the whole state
+static uint64_t mix(uint64_t value)
+{
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+
+    return value ^ (value >> 31);
+}
 
-namespace Random
+RandomStream::RandomStream(uint64_t seed, uint64_t sequence)
 {
-    int Range(int min, int max)
-    {
-        std::mt19937 rng(useSeed ? seed + offset : std::random_device()());
-        std::uniform_int_distribution<int> dist(min, max);
+    // The increment has to be odd, each sequence is a different generator
+    _state = 0;
+    _increment = (sequence << 1u) | 1u;
+    Next();
+    _state += seed;
+    Next();
+}
+
+RandomStream RandomStream::FromEntropy()
+{
+    std::random_device device;
 
-        if (useSeed)
-        {
-	        offset++;
-        }
+    return RandomStream(((uint64_t)device() << 32) | device(), ((uint64_t)device() << 32) | device());
+}
 
-        return dist(rng);
-    }
+int RandomStream::Range(int min, int max)
+{
+    auto range = (uint64_t)((int64_t)max - min + 1);
 
-    float Range(float min, float max)
+    // Lemire's multiply and shift, the few low values that would make some results more likely are rejected
+    uint64_t product = (uint64_t)Next() * range;
+
+    if ((uint32_t)product < range)
     {
-        std::mt19937 rng(useSeed ? seed + offset : std::random_device()());
-        std::uniform_real_distribution<float> dist(min, max);
+        auto threshold = (uint32_t)((0x100000000ULL - range) % range);
 
-        if (useSeed)
+        while ((uint32_t)product < threshold)
         {
-	        offset++;
+            product = (uint64_t)Next() * range;
         }
-
-        return dist(rng);
     }
 
-    void SetSeed(int newSeed)
-    {
-        seed = newSeed;
-    }
+    return (int)((int64_t)min + (int64_t)(product >> 32));
+}
 
-    void UseSeed()
-    {
-        useSeed = true;
-	    offset = 0;
-    }
+float RandomStream::Range(float min, float max)
+{
+    // The 24 high bits fill the mantissa, so the result is in [0, 1)
+    float value = (float)(Next() >> 8) * (1.f / 16777216.f);
 
-    void StopUseSeed()
-    {
-        useSeed = false;
-    }
+    return min + (max - min) * value;
+}
 
-    int GetSeed()
-    {
-        return seed;
-    }
-}
\ No newline at end of file
+RandomStream RandomStream::Split(uint64_t key) const
+{
+    return RandomStream(mix(_state ^ mix(key)), mix(_increment + key));
+}
@@ -6,15 +6,20 @@
 
 void Serialize(Serializer* serializer, void* dataPtr, size_t dataSize)
 {
+	size_t count;
+
 	if (serializer->IsWriting)
 	{
-		fwrite(dataPtr, dataSize, 1, serializer->FilePtr);
-
+		count = fwrite(dataPtr, dataSize, 1, serializer->FilePtr);
 	}
 	else
 	{
-		fread(dataPtr, dataSize, 1, serializer->FilePtr);
+		count = fread(dataPtr, dataSize, 1, serializer->FilePtr);
+	}
 
+	if (count != 1)
+	{
+		serializer->HasFailed = true;
 	}
 }
 
@@ -23,6 +28,10 @@ void Serialize(Serializer* serializer, int32_t* dataPtr) {
 	Serialize(serializer, dataPtr, sizeof(*dataPtr));
 }
 
+void Serialize(Serializer* serializer, int64_t* dataPtr) {
+	Serialize(serializer, dataPtr, sizeof(*dataPtr));
+}
+
 void Serialize(Serializer* serializer, float* dataPtr) {
 	Serialize(serializer, dataPtr, sizeof(*dataPtr));
 }
@@ -0,0 +1,394 @@
+#include "TaskScheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct Task
+{
+	std::function<void()> Function;
+	// Decremented once the task is done
+	std::atomic<int>* PendingCount = nullptr;
+};
+
+struct TaskDeque
+{
+	std::mutex Mutex;
+	std::deque<Task> Tasks;
+};
+
+// The deque 0 is for the threads that aren't workers, like the main thread
+std::vector<std::unique_ptr<TaskDeque>> taskDeques;
+std::vector<std::thread> workers;
+thread_local int workerIndex = 0;
+std::mutex startMutex;
+std::atomic<bool> isStarted = false;
+bool isDeterministicMode = false;
+
+// The workers sleep when all the deques are empty, a thread waiting for a group also sleeps until the group is done
+std::atomic<bool> isStopping = false;
+std::atomic<int> queuedTaskCount = 0;
+std::atomic<int> sleepingThreadCount = 0;
+std::mutex sleepMutex;
+std::condition_variable taskQueued;
+// Yields of a waiting thread before it sleeps, the last tasks of a group are often about to finish
+constexpr int waitSpinCount = 64;
+
+std::atomic<uint64_t> tasksRun = 0;
+std::atomic<uint64_t> steals = 0;
+std::atomic<int64_t> idleNanoseconds = 0;
+
+// Join the workers before the exit destroys them
+struct WorkerJoiner
+{
+	~WorkerJoiner() { TaskScheduler::Stop(); }
+} workerJoiner;
+
+void ensureStarted()
+{
+	if (!isStarted)
+	{
+		TaskScheduler::Start();
+	}
+}
+
+void wakeWorker()
+{
+	if (sleepingThreadCount > 0)
+	{
+		// Taking the lock makes sure a worker going to sleep either sees the task or gets the notification
+		{
+			std::lock_guard lock(sleepMutex);
+		}
+
+		taskQueued.notify_one();
+	}
+}
+
+void wakeWaitingThreads()
+{
+	if (sleepingThreadCount > 0)
+	{
+		{
+			std::lock_guard lock(sleepMutex);
+		}
+
+		// The workers go back to sleep, the thread waiting for the group wakes up
+		taskQueued.notify_all();
+	}
+}
+
+void pushTask(Task task)
+{
+	{
+		TaskDeque& deque = *taskDeques[workerIndex];
+		std::lock_guard lock(deque.Mutex);
+		deque.Tasks.push_back(std::move(task));
+	}
+
+	queuedTaskCount++;
+	wakeWorker();
+}
+
+bool popTask(Task& task)
+{
+	if (queuedTaskCount == 0) return false;
+
+	// The newest task of the own deque is the most likely to be in the cache
+	{
+		TaskDeque& deque = *taskDeques[workerIndex];
+		std::lock_guard lock(deque.Mutex);
+
+		if (!deque.Tasks.empty())
+		{
+			task = std::move(deque.Tasks.back());
+			deque.Tasks.pop_back();
+			queuedTaskCount--;
+			return true;
+		}
+	}
+
+	// Steal the oldest task of another deque, the biggest blocks of a split range are pushed first
+	auto dequeCount = (int)taskDeques.size();
+
+	for (int i = 1; i < dequeCount; i++)
+	{
+		TaskDeque& deque = *taskDeques[(workerIndex + i) % dequeCount];
+		std::lock_guard lock(deque.Mutex);
+
+		if (!deque.Tasks.empty())
+		{
+			task = std::move(deque.Tasks.front());
+			deque.Tasks.pop_front();
+			queuedTaskCount--;
+			steals++;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void runTask(Task& task)
+{
+	task.Function();
+	tasksRun++;
+
+	// The group can be destroyed by its waiting thread as soon as the count is 0, it's not used after
+	if (--(*task.PendingCount) == 0)
+	{
+		wakeWaitingThreads();
+	}
+}
+
+void runWorker(int index)
+{
+	workerIndex = index;
+
+	while (true)
+	{
+		Task task;
+
+		if (popTask(task))
+		{
+			runTask(task);
+			continue;
+		}
+
+		auto idleStart = std::chrono::steady_clock::now();
+
+		{
+			std::unique_lock lock(sleepMutex);
+
+			sleepingThreadCount++;
+			taskQueued.wait(lock, []() { return isStopping || queuedTaskCount > 0; });
+			sleepingThreadCount--;
+		}
+
+		idleNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - idleStart).count();
+
+		if (isStopping && queuedTaskCount == 0) return;
+	}
+}
+
+void TaskGroup::Run(std::function<void()> task)
+{
+	ensureStarted();
+
+	_pendingCount++;
+	pushTask({std::move(task), &_pendingCount});
+}
+
+void TaskGroup::Wait()
+{
+	int spinCount = 0;
+
+	while (_pendingCount > 0)
+	{
+		Task task;
+
+		if (popTask(task))
+		{
+			runTask(task);
+			spinCount = 0;
+			continue;
+		}
+
+		// Nothing to help with, the last tasks of the group are running on other threads
+		if (spinCount < waitSpinCount)
+		{
+			spinCount++;
+			std::this_thread::yield();
+			continue;
+		}
+
+		// Sleep until a task is queued or the group is done, instead of holding a core
+		std::unique_lock lock(sleepMutex);
+
+		sleepingThreadCount++;
+		taskQueued.wait(lock, [this]() { return _pendingCount == 0 || queuedTaskCount > 0; });
+		sleepingThreadCount--;
+	}
+}
+
+namespace TaskScheduler
+{
+	void Start(int workerCount)
+	{
+		std::lock_guard lock(startMutex);
+
+		if (isStarted) return;
+
+		// At least one worker
+		if (workerCount <= 0)
+		{
+			workerCount = std::max((int)std::thread::hardware_concurrency() - 1, 1);
+		}
+
+		isStopping = false;
+		taskDeques.clear();
+
+		for (int i = 0; i <= workerCount; i++)
+		{
+			taskDeques.push_back(std::make_unique<TaskDeque>());
+		}
+
+		for (int i = 1; i <= workerCount; i++)
+		{
+			workers.emplace_back(runWorker, i);
+		}
+
+		isStarted = true;
+	}
+
+	void Stop()
+	{
+		std::lock_guard lock(startMutex);
+
+		if (!isStarted) return;
+
+		{
+			std::lock_guard sleepLock(sleepMutex);
+			isStopping = true;
+		}
+
+		taskQueued.notify_all();
+
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+
+		workers.clear();
+		isStarted = false;
+	}
+
+	int GetThreadCount()
+	{
+		ensureStarted();
+
+		return (int)taskDeques.size();
+	}
+
+	void SetDeterministic(bool isDeterministic)
+	{
+		isDeterministicMode = isDeterministic;
+	}
+
+	bool IsDeterministic()
+	{
+		return isDeterministicMode;
+	}
+
+	void ParallelFor(int begin, int end, int grain, const std::function<void(int blockBegin, int blockEnd)>& function)
+	{
+		if (end <= begin) return;
+
+		grain = std::max(grain, 1);
+
+		// Otherwise a few blocks per thread, enough to even out the threads that are slowed down
+		int blockSize = isDeterministicMode ? grain : std::max(grain, (end - begin) / (GetThreadCount() * 4));
+
+		if (end - begin <= blockSize)
+		{
+			function(begin, end);
+			return;
+		}
+
+		TaskGroup group;
+
+		for (int blockBegin = begin; blockBegin < end; blockBegin += blockSize)
+		{
+			int blockEnd = std::min(blockBegin + blockSize, end);
+
+			group.Run([&function, blockBegin, blockEnd]() { function(blockBegin, blockEnd); });
+		}
+
+		group.Wait();
+	}
+
+	void ParallelForChunks(int minChunkX, int minChunkY, int maxChunkX, int maxChunkY, const std::function<void(int chunkX, int chunkY)>& function)
+	{
+		int width = maxChunkX - minChunkX;
+
+		if (width <= 0 || maxChunkY <= minChunkY) return;
+
+		ParallelFor(0, width * (maxChunkY - minChunkY), 1, [&](int blockBegin, int blockEnd)
+		{
+			for (int i = blockBegin; i < blockEnd; i++)
+			{
+				function(minChunkX + i % width, minChunkY + i / width);
+			}
+		});
+	}
+
+	TaskSchedulerStats GetStats()
+	{
+		return {tasksRun, steals, idleNanoseconds * 1e-9};
+	}
+
+	void ResetStats()
+	{
+		tasksRun = 0;
+		steals = 0;
+		idleNanoseconds = 0;
+	}
+}
+
+int TaskGraph::Add(std::function<void()> task, std::initializer_list<int> dependencies)
+{
+	auto id = (int)_nodes.size();
+
+	_nodes.push_back({std::move(task), {}, (int)dependencies.size()});
+
+	for (int dependency : dependencies)
+	{
+		_nodes[dependency].Successors.push_back(id);
+	}
+
+	return id;
+}
+
+void TaskGraph::Run()
+{
+	std::vector<std::atomic<int>> dependenciesLeft(_nodes.size());
+	TaskGroup group;
+
+	for (size_t i = 0; i < _nodes.size(); i++)
+	{
+		dependenciesLeft[i] = _nodes[i].DependencyCount;
+	}
+
+	// The last dependency of a task to finish starts it
+	std::function<void(int)> start = [&](int id)
+	{
+		group.Run([&, id]()
+		{
+			_nodes[id].Task();
+
+			for (int successor : _nodes[id].Successors)
+			{
+				if (--dependenciesLeft[successor] == 0)
+				{
+					start(successor);
+				}
+			}
+		});
+	};
+
+	for (size_t i = 0; i < _nodes.size(); i++)
+	{
+		if (_nodes[i].DependencyCount == 0)
+		{
+			start((int)i);
+		}
+	}
+
+	group.Wait();
+	_nodes.clear();
+}
@@ -1,4 +1,5 @@
 #include "Tile.h"
+#include "Timer.h"
 
 
 void Serialize(Serializer* ser, Tile* tile)
@@ -7,10 +8,29 @@ void Serialize(Serializer* ser, Tile* tile)
 	Serialize(ser, &tile->Progress);
 	Serialize(ser, &tile->IsBuilt);
 	Serialize(ser, &tile->NeedToBeDestroyed);
-	Serialize(ser, &tile->TreeGrowth);
-	Serialize(ser, &tile->TreeSpawnTimer);
 
-	for (auto& item : *tile->Inventory)
+	if (ser->DataVersion < SV_TickedTiles)
+	{
+		// The tree timers were in seconds, the grid is at the tick 0 when they are loaded
+		float treeGrowth = 0.f;
+		float treeSpawnTimer = 0.f;
+
+		Serialize(ser, &treeGrowth);
+		Serialize(ser, &treeSpawnTimer);
+
+		tile->TreePlantedTick = -(int64_t)(treeGrowth * Timer::TicksPerSecond);
+		tile->TreeNextSpawnTick = (int64_t)((30.f - treeSpawnTimer) * Timer::TicksPerSecond);
+	}
+	else
+	{
+		Serialize(ser, &tile->TreePlantedTick);
+		Serialize(ser, &tile->TreeNextSpawnTick);
+		Serialize(ser, &tile->BurnEndTick);
+		Serialize(ser, &tile->SmeltEndTick);
+		Serialize(ser, &tile->SmeltTicksLeft);
+	}
+
+	for (auto& item : tile->Inventory)
 	{
 		Serialize(ser, &item.second);//Items(i)
 
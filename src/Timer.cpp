@@ -1,45 +1,49 @@
 #include "Timer.h"
 
+#include <algorithm>
+
 #include "sokol_app.h"
 
+// Ring buffer of the last frame times, the sum is kept up to date instead of summing them every frame
+const int frameTimeCount = 200;
+float frameTimes[frameTimeCount];
 int frames = 0;
-float timeStack[200];
+int nextFrameTime = 0;
+double frameTimeSum = 0.0;
 
 namespace Timer
 {
     void Update()
     {
-        if (frames == 200)
+        DeltaTime = sapp_frame_duration();
+        Time += DeltaTime;
+
+        if (frames == frameTimeCount)
         {
-            for (int i = 0; i < 200; i++)
-            {
-                if (i == 199)
-                {
-                    timeStack[i] = DeltaTime;
-                }
-                else
-                {
-                    timeStack[i] = timeStack[i + 1];
-                }
-            }
+            frameTimeSum -= frameTimes[nextFrameTime];
         }
-
-        if (frames < 200)
+        else
         {
             frames++;
         }
 
-        DeltaTime = sapp_frame_duration();
-        timeStack[frames - 1] = DeltaTime;
-        Time += DeltaTime;
+        frameTimes[nextFrameTime] = DeltaTime;
+        frameTimeSum += DeltaTime;
+        nextFrameTime = (nextFrameTime + 1) % frameTimeCount;
 
-        auto sum = 0.f;
+        SmoothDeltaTime = (float)(frameTimeSum / frames);
+    }
 
-        for (auto i : timeStack)
-        {
-            sum += i;
-        }
+    int ConsumeTicks()
+    {
+        // Use the real frame time, a hitch runs more ticks in its frame instead of being spread over the next ones
+        TickAccumulator = std::min(TickAccumulator + DeltaTime, MaxTicksPerFrame * TickDuration);
+
+        int ticks = (int)(TickAccumulator / TickDuration);
+
+        TickAccumulator -= ticks * TickDuration;
+        TickAlpha = TickAccumulator / TickDuration;
 
-        SmoothDeltaTime = sum / frames;
+        return ticks;
     }
-}
\ No newline at end of file
+}
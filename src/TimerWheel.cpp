@@ -0,0 +1,81 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+void TimerWheel::Reset(int64_t tick)
+{
+	for (auto& level : _slots)
+	{
+		for (auto& slot : level)
+		{
+			slot.clear();
+		}
+	}
+
+	_overflow.clear();
+	_tick = tick;
+	_eventCount = 0;
+}
+
+void TimerWheel::Schedule(TimerEvent event)
+{
+	// Late events go to the next tick, the event keeps its due tick
+	insert(event, _tick + 1);
+	_eventCount++;
+}
+
+void TimerWheel::Advance(std::vector<TimerEvent>& dueEvents)
+{
+	_tick++;
+
+	// Bring the events of the higher levels down when the tick enters their slot, from the top so they can fall several levels
+	if ((_tick & ((int64_t(1) << (SlotBits * LevelCount)) - 1)) == 0)
+	{
+		cascade(_overflow);
+	}
+
+	for (int level = LevelCount - 1; level > 0; level--)
+	{
+		if ((_tick & ((int64_t(1) << (SlotBits * level)) - 1)) != 0) continue;
+
+		cascade(_slots[level][(_tick >> (SlotBits * level)) & (SlotCount - 1)]);
+	}
+
+	auto& slot = _slots[0][_tick & (SlotCount - 1)];
+
+	dueEvents.insert(dueEvents.end(), slot.begin(), slot.end());
+	_eventCount -= slot.size();
+	slot.clear();
+}
+
+void TimerWheel::insert(const TimerEvent& event, int64_t minTick)
+{
+	int64_t dueTick = std::max(event.DueTick, minTick);
+
+	// The lowest level where the due tick and the current tick are in the same turn of the level above
+	for (int level = 0; level < LevelCount; level++)
+	{
+		int shift = SlotBits * (level + 1);
+
+		if ((dueTick >> shift) == (_tick >> shift))
+		{
+			_slots[level][(dueTick >> (SlotBits * level)) & (SlotCount - 1)].push_back(event);
+			return;
+		}
+	}
+
+	_overflow.push_back(event);
+}
+
+void TimerWheel::cascade(std::vector<TimerEvent>& events)
+{
+	if (events.empty()) return;
+
+	std::vector<TimerEvent> cascadedEvents;
+	cascadedEvents.swap(events);
+
+	for (auto& event : cascadedEvents)
+	{
+		insert(event, _tick);
+	}
+}
@@ -1,32 +1,77 @@
 #include "UnitManager.h"
 
 #include <algorithm>
-#include <thread>
 #include "Graphics.h"
 #include "Timer.h"
 #include "Unit.h"
 #include "Grid.h"
+#include "TileDefinitions.h"
 #include "Random.h"
 #include "Logger.h"
+#include "TaskScheduler.h"
 
 float unitSpeed = 100.f;
 int unitSize = 16;
+// Units queued in the draw list by a task
+static constexpr int drawUnitSlice = 2048;
 float unitProgress;
 
-std::map<TileType, std::map<Items, int>>* unitMaxInventory = new std::map<TileType, std::map<Items, int>>
+// The planes of the types that store items, from the tile definitions
+constexpr uint32_t storagePlanes = []()
 {
-	{TileType::Sawmill, {{Items::Wood, 30}}},
-	{TileType::BuilderHut, {{Items::Wood, 30}, {Items::Stone, 20}}},
-	{TileType::LogisticsCenter, {{Items::Wood, 50}, {Items::Stone, 50}, {Items::Coal, 25}, {Items::IronOre, 25}, {Items::IronIngot, 10}}},
-};
+	uint32_t planes = 0;
+
+	for (auto& definition : TileDefinitions)
+	{
+		if (definition.IsStorage) planes |= TileQuery::Plane(definition.Type);
+	}
+
+	return planes;
+}();
+
+// The storages and the buildings that give the items they make
+constexpr uint32_t itemSourcePlanes = storagePlanes | TileQuery::Plane(TileType::Sawmill) | TileQuery::Plane(TileType::Quarry);
+
+// Built and not going to be destroyed
+constexpr TileQuery usableQuery(uint32_t typePlanes)
+{
+	return {TileQuery::Plane(ChunkPlanes::Built), TileQuery::Plane(ChunkPlanes::MarkedForDestruction), typePlanes};
+}
 
 void UnitManager::AddUnit(const Unit& unit)
 {
 	_units.push_back(unit);
+	_isRenderDirty = true;
+}
+
+void UnitManager::PrefetchChunks()
+{
+	for (auto& unit : _units)
+	{
+		_grid->PrefetchTile(_grid->GetTilePosition(unit.Position));
+
+		if (unit.CurrentBehavior == UnitBehavior::Moving)
+		{
+			_grid->PrefetchTile(unit.TargetTile);
+		}
+
+		// The drawing reads the job tile to pick the sprite of the unit
+		if (unit.JobTileIndex != -1)
+		{
+			_grid->PrefetchTile(_grid->GetTilePosition(unit.JobTileIndex));
+		}
+	}
 }
 
 void UnitManager::UpdateUnits()
 {
+	for (auto& unit : _units)
+	{
+		unit.PreviousPosition = unit.Position;
+	}
+
+	findRequestedPaths();
+
 	for (auto& unit : _units)
 	{
         SendInactiveBuildersToBuild();
@@ -38,11 +83,12 @@ void UnitManager::UpdateUnits()
 			if (tile.Type == TileType::None)
 			{
 				unit.JobTileIndex = -1;
+				_isRenderDirty = true;
 				unit.SetBehavior(UnitBehavior::Idle);
 				return;
 			}
 
-			unit.TimeSinceLastAction += Timer::SmoothDeltaTime;
+			unit.TimeSinceLastAction += Timer::TickDuration;
 
 			// Always the same for all units
 			if (unit.CurrentBehavior == UnitBehavior::Moving)
@@ -57,25 +103,22 @@ void UnitManager::UpdateUnits()
 				{
 					if (!unit.CalculatingPath)
 					{
-						// Start a new thread to calculate the path
+						// The path is found with the others at the start of the next tick
 						unit.CalculatingPath = true;
-						std::thread([&]()
-			            {
-							auto list = _grid->GetPath(_grid->GetTilePosition(unit.Position), unit.TargetTile);
-
-							if (list.empty())
-							{
-								unit.SetBehavior(UnitBehavior::Working);
-							}
-							else
-							{
-                                unit.PathToTargetTile = list;
-							}
-			            }).detach();
+						_pathRequests.push_back((int)(&unit - _units.data()));
 					}
 
-					if (!unit.PathToTargetTile.empty())
+					if (!unit.PathToTargetTile.empty() && !IsUnitDetailed(unit))
+					{
+						TravelCoarse(unit);
+					}
+					else if (!unit.PathToTargetTile.empty())
 					{
+						if (unit.TripDuration > 0.f)
+						{
+							ResumeTrip(unit);
+						}
+
 						auto nextPosition = GetNextUnitPosition(unit);
 						auto nextTileWorldPosition = GetNextTargetPosition(unit);
 
@@ -143,12 +186,13 @@ void UnitManager::UpdateUnits()
 			});
 
 			unit.JobTileIndex = jobs[0];
+			_isRenderDirty = true;
 		}
 
 		// Remove the overflow of items
 		if (unit.JobTileIndex == -1) continue;
 
-		for (auto& item: *unit.Inventory)
+		for (auto& item: unit.Inventory)
 		{
 			int max = GetMaxItemsFor(unit, item.first);
 
@@ -161,7 +205,7 @@ void UnitManager::UpdateUnits()
 
 	if (_units.size() < housesCount * 5)
 	{
-		unitProgress += Timer::SmoothDeltaTime;
+		unitProgress += Timer::TickDuration;
 
 		if (unitProgress > 20.f)
 		{
@@ -170,7 +214,7 @@ void UnitManager::UpdateUnits()
             // Spawn a new unit per house with 20% chance and still enough place
             for (auto& house : _grid->GetTiles(TileType::House))
             {
-                if (Random::Range(0, 100) < 20 && _units.size() < housesCount * 5)
+                if (_grid->GetTileRandom(house, _grid->GetTick()).Range(0, 100) < 20 && _units.size() < housesCount * 5)
                 {
                     AddUnit(Unit(_grid->ToWorldPosition(house) + Vector2F(0.5f, 1.f) * (float) (_grid->GetTileSize() - unitSize)));
                 }
@@ -179,6 +223,43 @@ void UnitManager::UpdateUnits()
 	}
 }
 
+void UnitManager::findRequestedPaths()
+{
+	if (_pathRequests.empty()) return;
+
+	std::vector<std::vector<TilePosition>> paths(_pathRequests.size());
+
+	// The tasks only read the grid and the units and write their own paths, nothing else runs until they are done
+	TaskScheduler::ParallelFor(0, (int)_pathRequests.size(), 1, [&](int firstRequest, int lastRequest)
+	{
+		for (int i = firstRequest; i < lastRequest; i++)
+		{
+			const Unit& unit = _units[_pathRequests[i]];
+
+			paths[i] = _grid->GetPath(_grid->GetTilePosition(unit.Position), unit.TargetTile);
+		}
+	});
+
+	for (size_t i = 0; i < _pathRequests.size(); i++)
+	{
+		Unit& unit = _units[_pathRequests[i]];
+
+		// It stopped moving since it asked for the path
+		if (unit.CurrentBehavior != UnitBehavior::Moving) continue;
+
+		if (paths[i].empty())
+		{
+			unit.SetBehavior(UnitBehavior::Working);
+		}
+		else
+		{
+			unit.PathToTargetTile = std::move(paths[i]);
+		}
+	}
+
+	_pathRequests.clear();
+}
+
 void UnitManager::OnTickUnitSawMill(Unit& unit)
 {
 	Tile& jobTile = _grid->GetTile(unit.JobTileIndex);
@@ -222,19 +303,19 @@ void UnitManager::OnTickUnitSawMill(Unit& unit)
 		{
 			// Drop the logs in the sawmill
 			int spaceLeft = Grid::GetLeftSpaceForItems(jobTile, Items::Wood);
-			int logsToDrop = std::min(unit.Inventory->at(Items::Wood), spaceLeft);
+			int logsToDrop = std::min(unit.Inventory.at(Items::Wood), spaceLeft);
 
-			unit.Inventory->at(Items::Wood) -= logsToDrop;
-			jobTile.Inventory->at(Items::Wood) += logsToDrop;
+			unit.Inventory.at(Items::Wood) -= logsToDrop;
+			_grid->AddItems(_grid->GetTilePosition(unit.JobTileIndex), Items::Wood, logsToDrop);
 
 			unit.SetBehavior(UnitBehavior::Idle);
 		}
 		// Harvest the tree
 		else if (unit.TimeSinceLastAction > 2.f)
 		{
-			tile.TreeGrowth = 0.f;
+			_grid->SetTreeGrowth(unit.TargetTile, 0.f);
 
-			unit.Inventory->at(Items::Wood) += 5;
+			unit.Inventory.at(Items::Wood) += 5;
 
 			unit.SetBehavior(UnitBehavior::Idle);
 		}
@@ -258,7 +339,7 @@ void UnitManager::OnTickUnitBuilderHut(Unit& unit)
 	{
         auto searchAStorage = [&]()
         {
-            for (auto pair : *unit.Inventory)
+            for (auto pair : unit.Inventory)
             {
                 if (pair.second == 0) continue;
 
@@ -314,13 +395,13 @@ void UnitManager::OnTickUnitBuilderHut(Unit& unit)
 			if (Grid::IsAStorage(tile.Type))
 			{
 				// Drop all the resources in the storage
-				for (auto pair : *unit.Inventory)
+				for (auto pair : unit.Inventory)
 				{
 					int spaceLeft = Grid::GetLeftSpaceForItems(tile, pair.first);
 					int itemsToDrop = std::min(pair.second, spaceLeft);
 
-					unit.Inventory->at(pair.first) -= itemsToDrop;
-					tile.Inventory->at(pair.first) += itemsToDrop;
+					unit.Inventory.at(pair.first) -= itemsToDrop;
+					_grid->AddItems(unit.TargetTile, pair.first, itemsToDrop);
 				}
 			}
 
@@ -328,19 +409,17 @@ void UnitManager::OnTickUnitBuilderHut(Unit& unit)
 			return;
 		}
 
-		tile.Progress += Timer::SmoothDeltaTime;
+		_grid->AddProgress(unit.TargetTile, Timer::TickDuration);
 
 		// Build the tile
 		if (!tile.IsBuilt && tile.Progress >= Grid::GetMaxConstructionProgress(tile.Type))
 		{
-			tile.IsBuilt = true;
-			tile.NeedToBeDestroyed = false;
-			tile.Progress = 0.f;
+			_grid->FinishConstruction(unit.TargetTile);
 
 			// Remove all the resources from the inventory of the tile that was used to build the tile
-			for (auto pair : *tile.Inventory)
+			for (auto pair : tile.Inventory)
 			{
-				tile.Inventory->at(pair.first) -= Grid::GetNeededItemsToBuild(tile.Type, pair.first);
+				_grid->AddItems(unit.TargetTile, pair.first, -Grid::GetNeededItemsToBuild(tile.Type, pair.first));
 			}
 
 			unit.SetBehavior(UnitBehavior::Idle);
@@ -350,20 +429,20 @@ void UnitManager::OnTickUnitBuilderHut(Unit& unit)
 		{
 			if (tile.Type == TileType::Tree)
 			{
-				unit.Inventory->at(Items::Wood) += 5;
+				unit.Inventory.at(Items::Wood) += 5;
 			}
 			else if (tile.Type == TileType::Stone)
 			{
-				unit.Inventory->at(Items::Stone) += 20;
+				unit.Inventory.at(Items::Stone) += 20;
 			}
 
             // Builder receive all the resources from the tile
-            for (auto pair : *tile.Inventory)
+            for (auto pair : tile.Inventory)
             {
-                unit.Inventory->at(pair.first) += pair.second;
+                unit.Inventory.at(pair.first) += pair.second;
             }
 
-			tile.Reset();
+			_grid->ResetTile(unit.TargetTile);
 			unit.SetBehavior(UnitBehavior::Idle);
 		}
 	}
@@ -392,7 +471,7 @@ void UnitManager::onTickUnitLogistician(Unit& unit)
 			auto tilePosition = buildsThatNeedResources[0];
 
 			// Check if the unit has the resources to build it or need to go to a storage to get them
-			for (auto pair : *_grid->GetTile(tilePosition).Inventory)
+			for (auto pair : _grid->GetTile(tilePosition).Inventory)
 			{
 				Items item = pair.first;
 				int quantity = pair.second;
@@ -401,7 +480,7 @@ void UnitManager::onTickUnitLogistician(Unit& unit)
 				if (quantity >= neededItems) continue;
 
 				int itemsToGet = neededItems - quantity;
-                int unitItem = unit.Inventory->at(item);
+                int unitItem = unit.Inventory.at(item);
 
 				// Check if the unit has the resources in his inventory or has his inventory full of this item
 				if (unitItem >= itemsToGet || unitItem == GetMaxItemsFor(unit, item)) continue;
@@ -433,12 +512,12 @@ void UnitManager::onTickUnitLogistician(Unit& unit)
             Tile& tile = _grid->GetTile(tilePosition);
             Items itemToGet = Items::Coal;
 
-            if (tile.Inventory->at(Items::Coal) >= Grid::GetMaxItemsStored(tile, Items::Coal) / 2)
+            if (tile.Inventory.at(Items::Coal) >= Grid::GetMaxItemsStored(tile, Items::Coal) / 2)
             {
                 itemToGet = Items::IronOre;
             }
 
-            if (unit.Inventory->at(itemToGet) > 0)
+            if (unit.Inventory.at(itemToGet) > 0)
             {
                 // Go to the furnace to drop the items
                 unit.TargetTile = tilePosition;
@@ -461,7 +540,7 @@ void UnitManager::onTickUnitLogistician(Unit& unit)
         if (!IsInventoryEmpty(unit))
         {
             // Search for a storage free space to drop the resources he has
-            for (auto pair : *unit.Inventory)
+            for (auto pair : unit.Inventory)
             {
                 if (pair.second == 0) continue;
 
@@ -476,9 +555,10 @@ void UnitManager::onTickUnitLogistician(Unit& unit)
         }
 
 		std::vector<TilePosition> tilesToGetItemsFrom = {};
-		auto sawmills = _grid->GetTiles(TileType::Sawmill);
-		auto quarries = _grid->GetTiles(TileType::Quarry);
-        auto furnaceToGet = _grid->GetTiles(TileType::Furnace);
+		// Copied since loading a paged out tile can change the lists
+		auto sawmills = std::vector<TilePosition>(_grid->GetTiles(TileType::Sawmill).begin(), _grid->GetTiles(TileType::Sawmill).end());
+		auto quarries = std::vector<TilePosition>(_grid->GetTiles(TileType::Quarry).begin(), _grid->GetTiles(TileType::Quarry).end());
+        auto furnaceToGet = std::vector<TilePosition>(_grid->GetTiles(TileType::Furnace).begin(), _grid->GetTiles(TileType::Furnace).end());
         auto addList = [&](const std::vector<TilePosition>& list)
         {
             for (auto tile : list)
@@ -488,12 +568,12 @@ void UnitManager::onTickUnitLogistician(Unit& unit)
                 if (IsTileTakenCareBy(tile, Characters::Logistician) || tileRef.GetInventorySize() == 0) continue;
 
                 // Check if any of the items in the tile can be pickup by the unit
-                for (auto pair : *_grid->GetTile(tile).Inventory)
+                for (auto pair : _grid->GetTile(tile).Inventory)
                 {
                     if (pair.second == 0) continue;
                     if (tileRef.Type == TileType::Furnace && pair.first != Items::IronIngot) continue;
 
-                    if (unit.Inventory->at(pair.first) < GetMaxItemsFor(unit, pair.first))
+                    if (unit.Inventory.at(pair.first) < GetMaxItemsFor(unit, pair.first))
                     {
                         tilesToGetItemsFrom.push_back(tile);
                         break;
@@ -522,7 +602,7 @@ void UnitManager::onTickUnitLogistician(Unit& unit)
 	}
 	else if (unit.CurrentBehavior == UnitBehavior::Working)
 	{
-		unit.TimeSinceLastAction += Timer::SmoothDeltaTime;
+		unit.TimeSinceLastAction += Timer::TickDuration;
 
 		if (unit.TimeSinceLastAction < 1.f) return;
 
@@ -531,17 +611,17 @@ void UnitManager::onTickUnitLogistician(Unit& unit)
 		// If it's a building that is not built, add the needed resources to it
 		if (!tile.IsBuilt)
 		{
-			for (auto pair : *tile.Inventory)
+			for (auto pair : tile.Inventory)
 			{
 				int neededItems = Grid::GetNeededItemsToBuild(tile.Type, pair.first);
 
 				if (pair.second >= neededItems) continue;
 
 				int itemsToGet = neededItems - pair.second;
-				int itemToDrop = std::min(unit.Inventory->at(pair.first), itemsToGet);
+				int itemToDrop = std::min(unit.Inventory.at(pair.first), itemsToGet);
 
-				unit.Inventory->at(pair.first) -= itemToDrop;
-				tile.Inventory->at(pair.first) += itemToDrop;
+				unit.Inventory.at(pair.first) -= itemToDrop;
+				_grid->AddItems(unit.TargetTile, pair.first, itemToDrop);
 			}
 		}
 		// If it's a storage, first check if there is something to build that need resources
@@ -556,7 +636,7 @@ void UnitManager::onTickUnitLogistician(Unit& unit)
                 Tile& buildTile = _grid->GetTile(tilePosition);
 
 				// Check if the unit has the resources to build it or need to go to a storage to get them
-				for (auto pair : *buildTile.Inventory)
+				for (auto pair : buildTile.Inventory)
 				{
 					Items item = pair.first;
 					int quantity = pair.second;
@@ -565,8 +645,8 @@ void UnitManager::onTickUnitLogistician(Unit& unit)
 					if (quantity >= neededItems) continue;
 
 					int itemsToGet = neededItems - quantity;
-                    int tileItem = tile.Inventory->at(item);
-                    int unitItem = unit.Inventory->at(item);
+                    int tileItem = tile.Inventory.at(item);
+                    int unitItem = unit.Inventory.at(item);
 
 					// Check if the unit has the resources in his inventory or has his inventory full of this item
 					if (unitItem >= itemsToGet || unitItem == GetMaxItemsFor(unit, item)) continue;
@@ -574,23 +654,23 @@ void UnitManager::onTickUnitLogistician(Unit& unit)
                     itemsToGet = std::min(itemsToGet, tileItem);
 
 					// Get the resources from the storage
-                    tile.Inventory->at(item) -= itemsToGet;
-                    unit.Inventory->at(item) += itemsToGet;
+                    _grid->AddItems(unit.TargetTile, item, -itemsToGet);
+                    unit.Inventory.at(item) += itemsToGet;
 				}
 			}
-            else if (!furnaces.empty() && (tile.Inventory->at(Items::Coal) > 0 || tile.Inventory->at(Items::IronOre) > 0))
+            else if (!furnaces.empty() && (tile.Inventory.at(Items::Coal) > 0 || tile.Inventory.at(Items::IronOre) > 0))
             {
                 auto furnaceTile = _grid->GetTile(furnaces[0]);
 
                 // Try to get the items from the storage (coal and iron ore)
-                for (auto pair : *tile.Inventory)
+                for (auto pair : tile.Inventory)
                 {
                     if (pair.second == 0 || (pair.first != Items::Coal && pair.first != Items::IronOre)) continue;
 
                     Items item = pair.first;
                     int quantity = pair.second;
-                    int neededItems = Grid::GetMaxItemsStored(furnaceTile, item) - furnaceTile.Inventory->at(item);
-                    int unitItem = unit.Inventory->at(item);
+                    int neededItems = Grid::GetMaxItemsStored(furnaceTile, item) - furnaceTile.Inventory.at(item);
+                    int unitItem = unit.Inventory.at(item);
 
                     // Check if the unit has the resources in his inventory or has his inventory full of this item
                     if (unitItem >= neededItems || unitItem == GetMaxItemsFor(unit, item)) continue;
@@ -598,15 +678,15 @@ void UnitManager::onTickUnitLogistician(Unit& unit)
                     int itemsToGet = std::min(GetMaxItemsFor(unit, item) - unitItem, std::min(quantity, neededItems));
 
                     // Get the resources from the storage
-                    tile.Inventory->at(item) -= itemsToGet;
-                    unit.Inventory->at(item) += itemsToGet;
+                    _grid->AddItems(unit.TargetTile, item, -itemsToGet);
+                    unit.Inventory.at(item) += itemsToGet;
                     break;
                 }
             }
 			// Check if there is resources to move to the storage from the unit
 			else
 			{
-				for (auto pair : *unit.Inventory)
+				for (auto pair : unit.Inventory)
 				{
 					if (pair.second == 0) continue;
 
@@ -615,47 +695,50 @@ void UnitManager::onTickUnitLogistician(Unit& unit)
 					int itemsToDropInStorage = std::min(itemsToDrop, spaceLeft);
 
 					// Drop the items
-					unit.Inventory->at(pair.first) -= itemsToDropInStorage;
-					tile.Inventory->at(pair.first) += itemsToDropInStorage;
+					unit.Inventory.at(pair.first) -= itemsToDropInStorage;
+					_grid->AddItems(unit.TargetTile, pair.first, itemsToDropInStorage);
 				}
 			}
 		}
 		// If it's a sawmill or a quarry, check if there is resources to get from it
 		else if (tile.Type == TileType::Sawmill || tile.Type == TileType::Quarry)
 		{
-			for (auto pair : *tile.Inventory)
+			for (auto pair : tile.Inventory)
 			{
 				if (pair.second == 0) continue;
 
 				int itemsToDrop = pair.second;
-				int spaceLeftInUnit = GetMaxItemsFor(unit, pair.first) - unit.Inventory->at(pair.first);
+				int spaceLeftInUnit = GetMaxItemsFor(unit, pair.first) - unit.Inventory.at(pair.first);
 				int itemsToDropInUnit = std::min(itemsToDrop, spaceLeftInUnit);
 
 				// Drop the items
-				unit.Inventory->at(pair.first) += itemsToDropInUnit;
-				tile.Inventory->at(pair.first) -= itemsToDropInUnit;
+				unit.Inventory.at(pair.first) += itemsToDropInUnit;
+				_grid->AddItems(unit.TargetTile, pair.first, -itemsToDropInUnit);
 			}
 		}
         // If it's a furnace, check if there is coal or iron ore to drop on it and iron ingots to get
         else if (tile.Type == TileType::Furnace)
         {
-            int coalToDrop = std::min(unit.Inventory->at(Items::Coal), Grid::GetMaxItemsStored(tile, Items::Coal) - tile.Inventory->at(Items::Coal));
-            int ironOreToDrop = std::min(unit.Inventory->at(Items::IronOre), Grid::GetMaxItemsStored(tile, Items::IronOre) - tile.Inventory->at(Items::IronOre));
+            int coalToDrop = std::min(unit.Inventory.at(Items::Coal), Grid::GetMaxItemsStored(tile, Items::Coal) - tile.Inventory.at(Items::Coal));
+            int ironOreToDrop = std::min(unit.Inventory.at(Items::IronOre), Grid::GetMaxItemsStored(tile, Items::IronOre) - tile.Inventory.at(Items::IronOre));
 
-            unit.Inventory->at(Items::Coal) -= coalToDrop;
-            unit.Inventory->at(Items::IronOre) -= ironOreToDrop;
+            unit.Inventory.at(Items::Coal) -= coalToDrop;
+            unit.Inventory.at(Items::IronOre) -= ironOreToDrop;
 
-            tile.Inventory->at(Items::Coal) += coalToDrop;
-            tile.Inventory->at(Items::IronOre) += ironOreToDrop;
+            _grid->AddItems(unit.TargetTile, Items::Coal, coalToDrop);
+            _grid->AddItems(unit.TargetTile, Items::IronOre, ironOreToDrop);
 
             // Check if there is iron ingots to get
-            if (tile.Inventory->at(Items::IronIngot) > 0)
+            if (tile.Inventory.at(Items::IronIngot) > 0)
             {
-                int ingotsToDrop = std::min(tile.Inventory->at(Items::IronIngot), GetMaxItemsFor(unit, Items::IronIngot) - unit.Inventory->at(Items::IronIngot));
+                int ingotsToDrop = std::min(tile.Inventory.at(Items::IronIngot), GetMaxItemsFor(unit, Items::IronIngot) - unit.Inventory.at(Items::IronIngot));
 
-                tile.Inventory->at(Items::IronIngot) -= ingotsToDrop;
-                unit.Inventory->at(Items::IronIngot) += ingotsToDrop;
+                _grid->AddItems(unit.TargetTile, Items::IronIngot, -ingotsToDrop);
+                unit.Inventory.at(Items::IronIngot) += ingotsToDrop;
             }
+
+            // The furnace can start burning or smelting with the new items
+            _grid->WakeTile(unit.TargetTile);
         }
 
 		unit.SetBehavior(UnitBehavior::Idle);
@@ -695,19 +778,21 @@ void UnitManager::OnTickUnitQuarry(Unit& unit)
 		// Check if the quarry is full
 		if (stoneLeftSpace != 0 || coalLeftSpace != 0 || ironOreLeftSpace != 0)
 		{
-			auto rand = Random::Range(0, 100);
+			// Split by unit so the quarrymen of the same quarry don't all dig the same thing
+			RandomStream random = _grid->GetTileRandom(unit.TargetTile, _grid->GetTick()).Split(&unit - _units.data());
+			auto rand = random.Range(0, 100);
 
 			if (rand < 5 && ironOreLeftSpace != 0)
 			{
-				tile.Inventory->at(Items::IronOre) += Random::Range(1, 5);
+				_grid->AddItems(unit.TargetTile, Items::IronOre, random.Range(1, 5));
 			}
 			else if (rand < 10 && coalLeftSpace != 0)
 			{
-				tile.Inventory->at(Items::Coal) += Random::Range(1, 3);
+				_grid->AddItems(unit.TargetTile, Items::Coal, random.Range(1, 3));
 			}
 			else if (stoneLeftSpace != 0)
 			{
-				tile.Inventory->at(Items::Stone) += 1;
+				_grid->AddItems(unit.TargetTile, Items::Stone, 1);
 			}
 		}
 
@@ -783,7 +868,7 @@ Vector2F UnitManager::GetNextUnitPosition(Unit& unit)
 	float speedFactor = 1.f;
 
 	// Check if the next tile is a road
-	if (_grid->GetTile(_grid->GetTilePosition(unit.Position)).Type == TileType::Road)
+	if (_grid->IsRoad(_grid->GetTilePosition(unit.Position)))
 	{
 		speedFactor = 1.5f;
 	}
@@ -791,7 +876,7 @@ Vector2F UnitManager::GetNextUnitPosition(Unit& unit)
 	speedFactor += Grid::GetSpeedFactor(tile.Type);
 
 	// Move it to the center of the next tile
-	auto offset = (nextTileWorldPosition - unit.Position).Normalized() * unitSpeed * speedFactor * Timer::SmoothDeltaTime;
+	auto offset = (nextTileWorldPosition - unit.Position).Normalized() * unitSpeed * speedFactor * Timer::TickDuration;
 
 	return unit.Position + offset;
 }
@@ -809,49 +894,135 @@ Vector2F UnitManager::GetNextTargetPosition(Unit& unit)
 	return nextTileWorldPosition;
 }
 
-void UnitManager::DrawUnits(bool drawBehindBuildings)
+bool UnitManager::IsUnitDetailed(Unit& unit)
 {
-	for (auto& unit : _units)
-	{
-		Characters character = GetCharacter(unit.JobTileIndex);
-		TilePosition tilePosition = _grid->GetTilePosition(unit.Position);
-		// Check if the character is positioned before 80% of the height of the tile
-		bool isBehindBuilding = tilePosition == _grid->GetTilePosition(unit.Position + Vector2F(0.f, _grid->GetTileSize() * 0.21f));
-
-		if (drawBehindBuildings != isBehindBuilding) continue;
-
-		Graphics::DrawObject({
-            .Position = unit.Position,
-            .Size = {unitSize, unitSize},
-            .Texture = Texture(character),
-        });
-	}
+	return _grid->IsDetailed(_grid->GetTilePosition(unit.Position)) || _grid->IsDetailed(unit.TargetTile);
 }
 
-Characters UnitManager::GetCharacter(int jobTileIndex)
+float UnitManager::GetTripDuration(Unit& unit)
 {
-	if (jobTileIndex == -1) return Characters::Unemployed;
+	// Same speed as the walk, tile by tile. Only the type of the job tile is read, it doesn't need its chunk to be loaded
+	float jobSpeedFactor = Grid::GetSpeedFactor(_grid->PeekTile(_grid->GetTilePosition(unit.JobTileIndex)).Type);
+	TilePosition from = _grid->GetTilePosition(unit.Position);
+	float duration = 0.f;
+
+	for (auto to : unit.PathToTargetTile)
+	{
+		float speedFactor = (_grid->IsRoad(from) ? 1.5f : 1.f) + jobSpeedFactor;
 
-	Tile& jobTile = _grid->GetTile(jobTileIndex);
+		duration += _grid->GetTileSize() / (unitSpeed * speedFactor);
+		from = to;
+	}
 
-	if (jobTile.Type == TileType::Sawmill)
+	return duration;
+}
+
+void UnitManager::TravelCoarse(Unit& unit)
+{
+	if (unit.TripDuration == 0.f)
 	{
-		return Characters::Lumberjack;
+		unit.TripDuration = GetTripDuration(unit);
 	}
-	else if (jobTile.Type == TileType::BuilderHut)
+
+	unit.TripTime += Timer::TickDuration;
+
+	if (unit.TripTime < unit.TripDuration) return;
+
+	// Arrive where the walk would have ended
+	unit.PathToTargetTile.erase(unit.PathToTargetTile.begin(), unit.PathToTargetTile.end() - 1);
+	unit.Position = GetNextTargetPosition(unit);
+	unit.PreviousPosition = unit.Position;
+	_isRenderDirty = true;
+
+	unit.SetBehavior(UnitBehavior::Working);
+}
+
+void UnitManager::ResumeTrip(Unit& unit)
+{
+	// Put the unit on the tile of its path it would have reached, the walk goes on from there
+	size_t walkedTiles = std::min((size_t)(unit.TripTime / unit.TripDuration * unit.PathToTargetTile.size()), unit.PathToTargetTile.size() - 1);
+
+	if (walkedTiles > 0)
 	{
-		return Characters::Builder;
+		unit.Position = _grid->ToWorldPosition(unit.PathToTargetTile[walkedTiles - 1]) + Vector2F(0.5f, 0.5f) * (float) (_grid->GetTileSize() - unitSize);
+		unit.PreviousPosition = unit.Position;
+		_isRenderDirty = true;
+		unit.PathToTargetTile.erase(unit.PathToTargetTile.begin(), unit.PathToTargetTile.begin() + walkedTiles);
 	}
-	else if (jobTile.Type == TileType::Quarry)
+
+	unit.TripTime = 0.f;
+	unit.TripDuration = 0.f;
+}
+
+void UnitManager::DrawUnits()
+{
+	// The units seen by the camera are found with their tile, they don't need the visibility test of each quad
+	TilePosition min, max;
+	_grid->GetVisibleTiles(min, max);
+
+	// The slices of units count their sprites, then write them where the sprites of the slices before them end
+	int sliceCount = ((int)_units.size() + drawUnitSlice - 1) / drawUnitSlice;
+	_drawSlices.assign(sliceCount, {});
+
+	for (int pass = 0; pass < 2; pass++)
 	{
-		return Characters::Digger;
+		TaskScheduler::ParallelFor(0, sliceCount, 1, [&](int firstSlice, int lastSlice)
+		{
+			for (int slice = firstSlice; slice < lastSlice; slice++)
+			{
+				int lastUnit = std::min((slice + 1) * drawUnitSlice, (int)_units.size());
+
+				for (int i = slice * drawUnitSlice; i < lastUnit; i++)
+				{
+					const Unit& unit = _units[i];
+					Vector2F position = unit.PreviousPosition.Lerp(unit.Position, Timer::TickAlpha);
+					TilePosition tilePosition = _grid->GetTilePosition(position);
+
+					if (tilePosition.X < min.X || tilePosition.X > max.X || tilePosition.Y < min.Y || tilePosition.Y > max.Y) continue;
+
+					_drawSlices[slice].Add(DrawLayer::Objects, position, {unitSize, unitSize}, Texture(peekCharacter(unit.JobTileIndex)));
+				}
+			}
+		});
+
+		if (pass == 0)
+		{
+			Graphics::PlaceDrawListRanges(_drawSlices);
+		}
 	}
-	else if (jobTile.Type == TileType::LogisticsCenter)
+
+	// The units drawn between two positions are somewhere else at the next frame, even if they stopped at the tick
+	_isRenderDirty = isAnyUnitMoving();
+}
+
+bool UnitManager::IsRenderDirty() const
+{
+	return _isRenderDirty || isAnyUnitMoving();
+}
+
+bool UnitManager::isAnyUnitMoving() const
+{
+	for (auto& unit : _units)
 	{
-		return Characters::Logistician;
+		if (unit.Position != unit.PreviousPosition) return true;
 	}
 
-	return Characters::Unemployed;
+	return false;
+}
+
+Characters UnitManager::GetCharacter(int jobTileIndex)
+{
+	if (jobTileIndex == -1) return Characters::Unemployed;
+
+	return GetTileDefinition(_grid->GetTile(jobTileIndex).Type).Worker;
+}
+
+Characters UnitManager::peekCharacter(int jobTileIndex) const
+{
+	if (jobTileIndex == -1) return Characters::Unemployed;
+
+	// The job tiles are prefetched with the units, a chunk still being read gives an unemployed unit for a frame
+	return GetTileDefinition(_grid->PeekTile(_grid->GetTilePosition(jobTileIndex)).Type).Worker;
 }
 
 bool UnitManager::IsTileTakenCareBy(TilePosition position, Characters character)
@@ -884,15 +1055,7 @@ int UnitManager::GetMaxUnitOnJob(int jobTileIndex)
 
 	if (!tile.IsBuilt) return true;
 
-	switch (tile.Type)
-	{
-		case TileType::Sawmill: return 2;
-		case TileType::BuilderHut: return 1;
-		case TileType::Quarry: return 2;
-		case TileType::LogisticsCenter: return 1;
-
-		default: return 0;
-	}
+	return GetTileDefinition(tile.Type).MaxWorkers;
 }
 
 int UnitManager::CountHowManyUnitAreWorkingOn(int jobTileIndex)
@@ -928,13 +1091,10 @@ std::vector<int> UnitManager::GetAllInactive(Characters character)
 std::vector<TilePosition> UnitManager::GetAllHarvestableTrees(TilePosition position, int radius)
 {
 	std::vector<TilePosition> trees = std::vector<TilePosition>();
-	auto treePositions = _grid->GetTiles(TileType::Tree, position, radius);
 
-	for (auto& treePosition : treePositions)
+	for (auto treePosition : _grid->QueryTiles(TileQuery::MatureTrees(), position, radius))
 	{
-		auto& treeTile = _grid->GetTile(treePosition);
-
-		if (treeTile.TreeGrowth < 30.f || IsTileTakenCareBy(treePosition, Characters::Lumberjack)) continue;
+		if (IsTileTakenCareBy(treePosition, Characters::Lumberjack)) continue;
 
 		trees.push_back(treePosition);
 	}
@@ -947,10 +1107,10 @@ bool UnitManager::NeedToDropItemsAtJob(Unit& unit, Items item, InventoryReason r
 	Tile& jobTile = _grid->GetTile(unit.JobTileIndex);
 	int maxItems = GetMaxItemsFor(unit, item);
 
-	if (jobTile.Inventory->at(item) == Grid::GetMaxItemsStored(jobTile, item)) return false;
-	if (reason == InventoryReason::Full && unit.Inventory->at(item) < maxItems) return false;
-	if (reason == InventoryReason::MoreThanHalf && unit.Inventory->at(item) < maxItems / 2) return false;
-	if (reason == InventoryReason::MoreThanOne && unit.Inventory->at(item) == 0) return false;
+	if (jobTile.Inventory.at(item) == Grid::GetMaxItemsStored(jobTile, item)) return false;
+	if (reason == InventoryReason::Full && unit.Inventory.at(item) < maxItems) return false;
+	if (reason == InventoryReason::MoreThanHalf && unit.Inventory.at(item) < maxItems / 2) return false;
+	if (reason == InventoryReason::MoreThanOne && unit.Inventory.at(item) == 0) return false;
 
 	return true;
 }
@@ -959,10 +1119,9 @@ std::vector<TilePosition> UnitManager::GetStorageAroundFor(TilePosition position
 {
 	std::vector<TilePosition> storages = std::vector<TilePosition>();
 
-    _grid->ForEachTile([&](Tile& tile, TilePosition position)
+    _grid->ForEachTile(usableQuery(storagePlanes), [&](Tile& tile, TilePosition position)
     {
-        if (!Grid::IsAStorage(tile.Type) || !tile.IsBuilt || tile.NeedToBeDestroyed) return;
-        if (tile.Inventory->at(item) == Grid::GetMaxItemsStored(tile, item)) return;
+        if (tile.Inventory.at(item) == Grid::GetMaxItemsStored(tile, item)) return;
 
         storages.push_back(position);
     });
@@ -980,9 +1139,9 @@ std::vector<TilePosition> UnitManager::GetAllBuildableOrDestroyableTiles()
 {
 	std::vector<TilePosition> tiles = std::vector<TilePosition>();
 
-	_grid->ForEachTile([&](Tile& tile, TilePosition position)
+	_grid->ForEachTile(TileQuery::Any(), [&](Tile& tile, TilePosition position)
 	{
-		if (IsTileTakenCareBy(position, Characters::Builder) || tile.Type == TileType::None) return;
+		if (IsTileTakenCareBy(position, Characters::Builder)) return;
 
 		if ((!tile.IsBuilt && Grid::IsTileReadyToBuild(tile)) || (tile.IsBuilt && tile.NeedToBeDestroyed))
 		{
@@ -998,17 +1157,18 @@ std::vector<TilePosition> UnitManager::GetTilesThatNeedItemsToBeBuilt()
 	std::vector<TilePosition> tiles = std::vector<TilePosition>();
 	auto items = GetAllUsableItems();
 
-	_grid->ForEachTile([&](Tile& tile, TilePosition position)
+	TileQuery notBuilt = {0, TileQuery::Plane(ChunkPlanes::Built), TileQuery::TypePlanes};
+
+	_grid->ForEachTile(notBuilt, [&](Tile& tile, TilePosition position)
     {
-        if (IsTileTakenCareBy(position, Characters::Logistician) || tile.Type == TileType::None) return;
-        if (Grid::IsTileReadyToBuild(tile) || tile.IsBuilt) return;
+        if (IsTileTakenCareBy(position, Characters::Logistician) || Grid::IsTileReadyToBuild(tile)) return;
 
         // Check if we have the items to build the tile
         bool canBuild = true;
 
         for (auto& item : items)
         {
-            if (Grid::GetNeededItemsToBuild(tile.Type, item.first) - tile.Inventory->at(item.first) > item.second)
+            if (Grid::GetNeededItemsToBuild(tile.Type, item.first) - tile.Inventory.at(item.first) > item.second)
             {
                 canBuild = false;
                 break;
@@ -1027,11 +1187,9 @@ std::vector<TilePosition> UnitManager::GetStorageThatHave(TilePosition position,
 {
 	std::vector<TilePosition> storages = std::vector<TilePosition>();
 
-	_grid->ForEachTile([&](Tile& tile, TilePosition position)
+	_grid->ForEachTile(usableQuery(itemSourcePlanes), [&](Tile& tile, TilePosition position)
 	{
-        if (tile.Type == TileType::None || !tile.IsBuilt || tile.NeedToBeDestroyed) return;
-		if (!Grid::IsAStorage(tile.Type) && tile.Type != TileType::Sawmill && tile.Type != TileType::Quarry) return;
-		if (tile.Inventory->at(item) == 0) return;
+		if (tile.Inventory.at(item) == 0) return;
 
 		storages.push_back(position);
 	});
@@ -1049,11 +1207,10 @@ std::vector<int> UnitManager::GetAvailableJobs()
 {
 	std::vector<int> jobs = std::vector<int>();
 
-	_grid->ForEachTile([&](Tile& tile, TilePosition position)
+	_grid->ForEachTile(TileQuery::Any(), [&](Tile& tile, TilePosition position)
 	{
 		int index = _grid->GetTileIndex(position);
 
-		if (tile.Type == TileType::None) return;
 		if (IsTileJobFull(index)) return;
 
 		jobs.push_back(index);
@@ -1066,12 +1223,10 @@ std::vector<TilePosition> UnitManager::GetFurnacesThatNeedItems()
 {
     std::vector<TilePosition> furnaces = std::vector<TilePosition>();
 
-    _grid->ForEachTile([&](Tile& tile, TilePosition position)
+    _grid->ForEachTile(usableQuery(TileQuery::Plane(TileType::Furnace)), [&](Tile& tile, TilePosition position)
     {
-        if (tile.Type != TileType::Furnace || !tile.IsBuilt || tile.NeedToBeDestroyed) return;
-
-        if (tile.Inventory->at(Items::Coal) < Grid::GetMaxItemsStored(tile, Items::Coal) ||
-            tile.Inventory->at(Items::IronOre) < Grid::GetMaxItemsStored(tile, Items::IronOre))
+        if (tile.Inventory.at(Items::Coal) < Grid::GetMaxItemsStored(tile, Items::Coal) ||
+            tile.Inventory.at(Items::IronOre) < Grid::GetMaxItemsStored(tile, Items::IronOre))
         {
             furnaces.push_back(position);
         }
@@ -1082,8 +1237,8 @@ std::vector<TilePosition> UnitManager::GetFurnacesThatNeedItems()
     {
         Tile& tileA = _grid->GetTile(a);
         Tile& tileB = _grid->GetTile(b);
-        int aItems = tileA.Inventory->at(Items::Coal) + tileA.Inventory->at(Items::IronOre);
-        int bItems = tileB.Inventory->at(Items::Coal) + tileB.Inventory->at(Items::IronOre);
+        int aItems = tileA.Inventory.at(Items::Coal) + tileA.Inventory.at(Items::IronOre);
+        int bItems = tileB.Inventory.at(Items::Coal) + tileB.Inventory.at(Items::IronOre);
 
         return aItems < bItems;
     });
@@ -1099,17 +1254,12 @@ int UnitManager::GetMaxItemsFor(Unit& unit, Items item)
 
 	if (!tile.IsBuilt) return 0;
 
-	if (!unitMaxInventory->contains(tile.Type) || !unitMaxInventory->at(tile.Type).contains(item))
-	{
-		return 0;
-	}
-
-	return unitMaxInventory->at(tile.Type).at(item);
+	return GetTileDefinition(tile.Type).MaxItemsCarried[(int)item];
 }
 
 bool UnitManager::IsInventoryEmpty(Unit& unit)
 {
-	for (auto& item : *unit.Inventory)
+	for (auto& item : unit.Inventory)
 	{
 		if (item.second > 0) return false;
 	}
@@ -1119,7 +1269,7 @@ bool UnitManager::IsInventoryEmpty(Unit& unit)
 
 bool UnitManager::IsInventoryHalfFull(Unit& unit)
 {
-    for (auto& item : *unit.Inventory)
+    for (auto& item : unit.Inventory)
     {
         if (item.second > GetMaxItemsFor(unit, item.first) / 2)
         {
@@ -1130,14 +1280,9 @@ bool UnitManager::IsInventoryHalfFull(Unit& unit)
     return false;
 }
 
-std::map<Items, int> UnitManager::GetAllUsableItems()
+ItemStock UnitManager::GetAllUsableItems()
 {
-	std::map<Items, int> items = std::map<Items, int>();
-
-	for (int i = 0; i < (int) Items::Count; i++)
-	{
-		items.insert(std::pair<Items, int>((Items) i, 0));
-	}
+	ItemStock items;
 
 	// Add all items from logisticians
 	for (auto& unit : _units)
@@ -1148,23 +1293,16 @@ std::map<Items, int> UnitManager::GetAllUsableItems()
 
 		if (tile.Type != TileType::LogisticsCenter) continue;
 
-		for (auto& item : *unit.Inventory)
+		for (auto& item : unit.Inventory)
 		{
 			items.at(item.first) += item.second;
 		}
 	}
 
-    auto isValidToCountItemsFromIt = [&](TileType type)
-    {
-        return Grid::IsAStorage(type) || type == TileType::Sawmill || type == TileType::Quarry;
-    };
-
 	// Add all items from storages
-	_grid->ForEachTile([&](Tile& tile, TilePosition position)
+	_grid->ForEachTile(usableQuery(itemSourcePlanes), [&](Tile& tile, TilePosition)
 	{
-		if (!tile.IsBuilt || tile.NeedToBeDestroyed || !isValidToCountItemsFromIt(tile.Type)) return;
-
-		for (auto& item : *tile.Inventory)
+		for (auto& item : tile.Inventory)
 		{
 			items.at(item.first) += item.second;
 		}
@@ -1179,11 +1317,11 @@ bool UnitManager::HasAtLeastOneItemNeededToBuild(Unit& unit, TilePosition positi
 
     if (tile.Type == TileType::None) return false;
 
-    for (auto& item : *tile.Inventory)
+    for (auto& item : tile.Inventory)
     {
         if (Grid::GetNeededItemsToBuild(tile.Type, item.first) - item.second <= 0) continue;
 
-        if (unit.Inventory->at(item.first) > 0) return true;
+        if (unit.Inventory.at(item.first) > 0) return true;
     }
 
     return false;
@@ -1211,11 +1349,21 @@ void Serialize(Serializer* ser, Unit* unit)
 	Serialize(ser, &unit->Position);
 	Serialize(ser, &unit->TargetTile);
 
-	for (auto& item : *unit->Inventory)
+	// The tile the unit goes to moves with the tiles of the old saves
+	if (!ser->IsWriting && ser->DataVersion < SV_ChunkedGrid)
+	{
+		unit->TargetTile.X -= ser->LegacyTileOffsetX;
+		unit->TargetTile.Y -= ser->LegacyTileOffsetY;
+	}
+
+	for (auto& item : unit->Inventory)
 	{
 		Serialize(ser, &item.second);//Items(i)
 		//printf("Element %i : %i \n ", item.first, item.second); //Debug Unit Inventory 
 	}
+
+	// Don't interpolate from where the unit was before the load
+	unit->PreviousPosition = unit->Position;
 }
 
 void Serialize(Serializer* ser, UnitManager* unitManager)